@@ -0,0 +1,549 @@
+/********************************************************************************
+* @file    acs.c
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Файл описывает реализации шагов сложения-сравнения-выбора (ACS) декодера
+  * Витерби. Векторные реализации обрабатывают состояния в естественном порядке:
+  * метрики предшественников state/2 и state/2 + S/2 размножаются распаковкой
+  * (перестановкой) регистра, метрики ветвей выбираются по таблице
+  * branchIndexTable, решения упаковываются movemask (маской сравнения для
+  * AVX-512). Метрики путей между шагами остаются в регистрах. Сравнение по
+  * знаку 16-разрядной разности и выбор при равенстве пути из state/2 совпадают
+  * со скалярной реализацией, поэтому метрики и решения всех реализаций одинаковы.
+  * Пакетные реализации векторизуют не состояния, а кадры: элемент регистра -
+  * метрика одного состояния в одном из ACS_LANES кадров
+  *
+  ******************************************************************************
+*/
+
+#include "acs.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (N == 2) && (S == 64)
+#define ACS_X86                                             //векторные реализации доступны
+#include <immintrin.h>
+#endif
+
+tAcsRun acsRun = acsRunScalar;
+tAcsBatchRun acsBatchRun = acsBatchRunScalar;
+
+/**
+ * @brief текущая реализация шагов ACS
+ */
+static eAcsKernel currentKernel = ACS_SCALAR;
+
+/**
+ * @brief скалярная реализация шагов ACS (см. tAcsRun)
+ */
+void acsRunScalar(uint16_t metric[S], const uint16_t (*branch)[1 << N], unsigned int steps,
+                  uint64_t *decisions)
+{
+    uint16_t buffer[2][S];                                  //метрики путей до и после шага
+    unsigned int current = 0;                               //индекс актуальных метрик
+    unsigned int state;                                     //итератор по состояниям
+    unsigned int t;                                         //итератор по шагам
+    for(state = 0; state < S; state = state + 1)
+    {
+        buffer[current][state] = metric[state];
+    }
+    for(t = 0; t < steps; t = t + 1)
+    {
+        const uint16_t *oldMetric = buffer[current];
+        uint16_t *newMetric = buffer[current ^ 1];
+        uint64_t stepDecisions = 0;                         //решения шага
+        for(state = 0; state < S; state = state + 1)
+        {
+            unsigned int bit = state & 1;                   //входной символ перехода
+            unsigned int low = state >> 1;                  //предшественник со сброшенным старшим разрядом
+            unsigned int high = low | (S >> 1);             //предшественник с установленным старшим разрядом
+            uint16_t metric0 = oldMetric[low] + branch[t][outputTable[low][bit]];
+            uint16_t metric1 = oldMetric[high] + branch[t][outputTable[high][bit]];
+            uint64_t decision = (int16_t)(metric0 - metric1) > 0;   //выживает путь с меньшей метрикой, при равенстве - из low
+            newMetric[state] = decision ? metric1 : metric0;    //выбор без ветвления: время шага не зависит от ошибок
+            stepDecisions |= decision << state;
+        }
+        decisions[t] = stepDecisions;
+        current = current ^ 1;
+    }
+    for(state = 0; state < S; state = state + 1)
+    {
+        metric[state] = buffer[current][state];
+    }
+}
+
+/**
+ * @brief скалярная пакетная реализация шагов ACS (см. tAcsBatchRun)
+ */
+void acsBatchRunScalar(uint16_t metric[S][ACS_LANES], const uint16_t (*branch)[1 << N][ACS_LANES],
+                       unsigned int steps, uint32_t (*decisions)[S])
+{
+    uint16_t buffer[2][S][ACS_LANES];                       //метрики путей до и после шага
+    unsigned int current = 0;                               //индекс актуальных метрик
+    unsigned int state;                                     //итератор по состояниям
+    unsigned int lane;                                      //итератор по кадрам
+    unsigned int t;                                         //итератор по шагам
+    memcpy(buffer[current], metric, sizeof(buffer[current]));
+    for(t = 0; t < steps; t = t + 1)
+    {
+        uint16_t (*oldMetric)[ACS_LANES] = buffer[current];
+        uint16_t (*newMetric)[ACS_LANES] = buffer[current ^ 1];
+        for(state = 0; state < S; state = state + 1)
+        {
+            unsigned int bit = state & 1;                   //входной символ перехода
+            unsigned int low = state >> 1;                  //предшественник со сброшенным старшим разрядом
+            unsigned int high = low | (S >> 1);             //предшественник с установленным старшим разрядом
+            const uint16_t *branch0 = branch[t][outputTable[low][bit]];
+            const uint16_t *branch1 = branch[t][outputTable[high][bit]];
+            uint32_t mask = 0;                              //решения состояния по кадрам
+            for(lane = 0; lane < ACS_LANES; lane = lane + 1)
+            {
+                uint16_t metric0 = oldMetric[low][lane] + branch0[lane];
+                uint16_t metric1 = oldMetric[high][lane] + branch1[lane];
+                uint32_t decision = (int16_t)(metric0 - metric1) > 0;
+                newMetric[state][lane] = decision ? metric1 : metric0;
+                mask |= decision << lane;
+            }
+            decisions[t][state] = mask;
+        }
+        current = current ^ 1;
+    }
+    memcpy(metric, buffer[current], sizeof(buffer[current]));
+}
+
+#ifdef ACS_X86
+/**
+ * @brief метрики ветвей кодов 0..3 в младших 8 байтах регистра
+ * @param
+ *  branch - метрики ветвей шага
+ */
+__attribute__((target("sse2")))
+static inline __m128i branchTable(const uint16_t branch[1 << N])
+{
+    return _mm_loadl_epi64((const __m128i *)branch);
+}
+
+/**
+ * @brief выбор метрик ветвей 8 состояний без перестановки байтов (SSE2):
+ *        метрика каждой ветви выбирается сравнением ее индекса с индексами кодов
+ * @param
+ *  index - индексы метрик ветвей (см. branchIndexTable)
+ *  codeIndex - индексы кодов 0..3
+ *  branch - метрики ветвей кодов 0..3, размноженные по регистру
+ */
+__attribute__((target("sse2")))
+static inline __m128i selectSse2(__m128i index, const __m128i codeIndex[4], const __m128i branch[4])
+{
+    __m128i metric = _mm_and_si128(_mm_cmpeq_epi16(index, codeIndex[0]), branch[0]);
+    metric = _mm_or_si128(metric, _mm_and_si128(_mm_cmpeq_epi16(index, codeIndex[1]), branch[1]));
+    metric = _mm_or_si128(metric, _mm_and_si128(_mm_cmpeq_epi16(index, codeIndex[2]), branch[2]));
+    return _mm_or_si128(metric, _mm_and_si128(_mm_cmpeq_epi16(index, codeIndex[3]), branch[3]));
+}
+
+/**
+ * @brief сложение-сравнение-выбор для 8 состояний (SSE2)
+ * @param
+ *  low, high - метрики предшественников state/2 и state/2 + S/2
+ *  branchLow, branchHigh - метрики ветвей из этих предшественников
+ *  decision - маска решений (0xFFFF, если выжил путь из state/2 + S/2)
+ * @return метрики путей после шага
+ */
+__attribute__((target("sse2")))
+static inline __m128i butterflySse2(__m128i low, __m128i high, __m128i branchLow, __m128i branchHigh,
+                                    __m128i *decision)
+{
+    __m128i metric0 = _mm_add_epi16(low, branchLow);
+    __m128i metric1 = _mm_add_epi16(high, branchHigh);
+    *decision = _mm_cmpgt_epi16(_mm_sub_epi16(metric0, metric1), _mm_setzero_si128());
+    return _mm_xor_si128(metric0, _mm_and_si128(_mm_xor_si128(metric0, metric1), *decision));
+}
+
+/**
+ * @brief реализация шагов ACS на SSE2 (см. tAcsRun)
+ */
+__attribute__((target("sse2")))
+static void acsRunSse2(uint16_t metric[S], const uint16_t (*branch)[1 << N], unsigned int steps,
+                       uint64_t *decisions)
+{
+    __m128i codeIndex[4];                                   //индексы метрик ветвей кодов 0..3
+    __m128i index[2][S/8];                                  //индексы метрик ветвей всех состояний
+    __m128i current[S/8];                                   //метрики путей, по 8 состояний
+    unsigned int i, t;
+    for(i = 0; i < 4; i = i + 1)
+    {
+        codeIndex[i] = _mm_set1_epi16((2*i) | ((2*i + 1) << 8));
+    }
+    for(i = 0; i < S/8; i = i + 1)
+    {
+        index[0][i] = _mm_loadu_si128((const __m128i *)(branchIndexTable[0] + 8*i));
+        index[1][i] = _mm_loadu_si128((const __m128i *)(branchIndexTable[1] + 8*i));
+        current[i] = _mm_loadu_si128((const __m128i *)(metric + 8*i));
+    }
+
+    for(t = 0; t < steps; t = t + 1)
+    {
+        __m128i value[4];                                   //метрики ветвей кодов 0..3, размноженные по регистру
+        __m128i next[S/8];                                  //метрики путей после шага
+        __m128i decision[2];
+        uint64_t stepDecisions = 0;                         //решения шага
+        for(i = 0; i < 4; i = i + 1)
+        {
+            value[i] = _mm_set1_epi16(branch[t][i]);
+        }
+#pragma GCC unroll 4
+        for(i = 0; i < S/16; i = i + 1)                     //предшественники состояний 16*i..16*i+15
+        {
+            __m128i low = current[i];
+            __m128i high = current[S/16 + i];
+            next[2*i] = butterflySse2(_mm_unpacklo_epi16(low, low), _mm_unpacklo_epi16(high, high),
+                                      selectSse2(index[0][2*i], codeIndex, value),
+                                      selectSse2(index[1][2*i], codeIndex, value), &decision[0]);
+            next[2*i + 1] = butterflySse2(_mm_unpackhi_epi16(low, low), _mm_unpackhi_epi16(high, high),
+                                          selectSse2(index[0][2*i + 1], codeIndex, value),
+                                          selectSse2(index[1][2*i + 1], codeIndex, value), &decision[1]);
+            stepDecisions |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_packs_epi16(decision[0], decision[1])) << (16*i);
+        }
+#pragma GCC unroll 8
+        for(i = 0; i < S/8; i = i + 1)
+        {
+            current[i] = next[i];
+        }
+        decisions[t] = stepDecisions;
+    }
+    for(i = 0; i < S/8; i = i + 1)
+    {
+        _mm_storeu_si128((__m128i *)(metric + 8*i), current[i]);
+    }
+}
+
+/**
+ * @brief сложение-сравнение-выбор для 16 состояний (AVX2)
+ * @param
+ *  low, high - метрики предшественников state/2 и state/2 + S/2
+ *  branchLow, branchHigh - метрики ветвей из этих предшественников
+ *  decision - маска решений (0xFFFF, если выжил путь из state/2 + S/2)
+ * @return метрики путей после шага
+ */
+__attribute__((target("avx2")))
+static inline __m256i butterflyAvx2(__m256i low, __m256i high, __m256i branchLow, __m256i branchHigh,
+                                    __m256i *decision)
+{
+    __m256i metric0 = _mm256_add_epi16(low, branchLow);
+    __m256i metric1 = _mm256_add_epi16(high, branchHigh);
+    *decision = _mm256_cmpgt_epi16(_mm256_sub_epi16(metric0, metric1), _mm256_setzero_si256());
+    return _mm256_blendv_epi8(metric0, metric1, *decision);
+}
+
+/**
+ * @brief упаковка масок решений 32 состояний подряд в биты (AVX2)
+ * @param
+ *  decision0, decision1 - маски решений состояний 0..15 и 16..31 группы
+ */
+__attribute__((target("avx2")))
+static inline uint32_t packAvx2(__m256i decision0, __m256i decision1)
+{
+    return _mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(decision0, decision1), 0xD8));
+}
+
+/**
+ * @brief реализация шагов ACS на AVX2 (см. tAcsRun)
+ */
+__attribute__((target("avx2")))
+static void acsRunAvx2(uint16_t metric[S], const uint16_t (*branch)[1 << N], unsigned int steps,
+                       uint64_t *decisions)
+{
+    __m256i index[2][4];                                    //индексы метрик ветвей всех состояний
+    __m256i current[4];                                     //метрики путей, по 16 состояний
+    unsigned int i, t;
+    for(i = 0; i < 4; i = i + 1)
+    {
+        index[0][i] = _mm256_loadu_si256((const __m256i *)(branchIndexTable[0] + 16*i));
+        index[1][i] = _mm256_loadu_si256((const __m256i *)(branchIndexTable[1] + 16*i));
+        current[i] = _mm256_loadu_si256((const __m256i *)(metric + 16*i));
+    }
+
+    for(t = 0; t < steps; t = t + 1)
+    {
+        __m256i table = _mm256_broadcastsi128_si256(branchTable(branch[t]));
+        __m256i decision[4];
+        //после перестановки четвертей распаковка дает метрики state/2 для состояний подряд
+        __m256i low0 = _mm256_permute4x64_epi64(current[0], 0xD8);
+        __m256i low1 = _mm256_permute4x64_epi64(current[1], 0xD8);
+        __m256i high0 = _mm256_permute4x64_epi64(current[2], 0xD8);
+        __m256i high1 = _mm256_permute4x64_epi64(current[3], 0xD8);
+        current[0] = butterflyAvx2(_mm256_unpacklo_epi16(low0, low0), _mm256_unpacklo_epi16(high0, high0),
+                                   _mm256_shuffle_epi8(table, index[0][0]), _mm256_shuffle_epi8(table, index[1][0]),
+                                   &decision[0]);
+        current[1] = butterflyAvx2(_mm256_unpackhi_epi16(low0, low0), _mm256_unpackhi_epi16(high0, high0),
+                                   _mm256_shuffle_epi8(table, index[0][1]), _mm256_shuffle_epi8(table, index[1][1]),
+                                   &decision[1]);
+        current[2] = butterflyAvx2(_mm256_unpacklo_epi16(low1, low1), _mm256_unpacklo_epi16(high1, high1),
+                                   _mm256_shuffle_epi8(table, index[0][2]), _mm256_shuffle_epi8(table, index[1][2]),
+                                   &decision[2]);
+        current[3] = butterflyAvx2(_mm256_unpackhi_epi16(low1, low1), _mm256_unpackhi_epi16(high1, high1),
+                                   _mm256_shuffle_epi8(table, index[0][3]), _mm256_shuffle_epi8(table, index[1][3]),
+                                   &decision[3]);
+        decisions[t] = packAvx2(decision[0], decision[1]) | ((uint64_t)packAvx2(decision[2], decision[3]) << 32);
+    }
+    for(i = 0; i < 4; i = i + 1)
+    {
+        _mm256_storeu_si256((__m256i *)(metric + 16*i), current[i]);
+    }
+}
+
+/**
+ * @brief коды ветвей в состояния 2j, 2j+1 из предшественников j и j + S/2
+ *        (по байту, младший - из j в 2j) для пакетных реализаций
+ * @param
+ *  codes - коды S/2 пар состояний
+ */
+static void batchCodes(uint32_t codes[S/2])
+{
+    unsigned int j;
+    for(j = 0; j < S/2; j = j + 1)
+    {
+        codes[j] = outputTable[j][0] | (outputTable[j + S/2][0] << 8)
+                 | (outputTable[j][1] << 16) | ((uint32_t)outputTable[j + S/2][1] << 24);
+    }
+}
+
+/**
+ * @brief пакетная реализация шагов ACS на AVX2 (см. tAcsBatchRun): метрики
+ *        одного состояния во всех ACS_LANES кадрах занимают два регистра, пара
+ *        состояний 2j, 2j+1 вычисляется из общих предшественников j и j + S/2
+ */
+__attribute__((target("avx2")))
+static void acsBatchRunAvx2(uint16_t metric[S][ACS_LANES], const uint16_t (*branch)[1 << N][ACS_LANES],
+                            unsigned int steps, uint32_t (*decisions)[S])
+{
+    __m256i buffer[2][S][2];                                //метрики путей до и после шага
+    uint32_t codes[S/2];                                    //коды ветвей пар состояний
+    unsigned int current = 0;                               //индекс актуальных метрик
+    unsigned int state, t, j, h;
+    batchCodes(codes);
+    for(state = 0; state < S; state = state + 1)
+    {
+        buffer[current][state][0] = _mm256_loadu_si256((const __m256i *)metric[state]);
+        buffer[current][state][1] = _mm256_loadu_si256((const __m256i *)(metric[state] + 16));
+    }
+
+    for(t = 0; t < steps; t = t + 1)
+    {
+        __m256i (*oldMetric)[2] = buffer[current];
+        __m256i (*newMetric)[2] = buffer[current ^ 1];
+        __m256i value[1 << N][2];                           //метрики ветвей кодов 0..3 по кадрам
+        for(j = 0; j < (1 << N); j = j + 1)
+        {
+            value[j][0] = _mm256_loadu_si256((const __m256i *)branch[t][j]);
+            value[j][1] = _mm256_loadu_si256((const __m256i *)(branch[t][j] + 16));
+        }
+        for(j = 0; j < S/2; j = j + 1)
+        {
+            uint32_t code = codes[j];
+            __m256i decision[2][2];
+            for(h = 0; h < 2; h = h + 1)                    //половины кадров 0..15 и 16..31
+            {
+                __m256i low = oldMetric[j][h];
+                __m256i high = oldMetric[j + S/2][h];
+                newMetric[2*j][h] = butterflyAvx2(low, high, value[code & 0xFF][h], value[(code >> 8) & 0xFF][h],
+                                                  &decision[0][h]);
+                newMetric[2*j + 1][h] = butterflyAvx2(low, high, value[(code >> 16) & 0xFF][h], value[code >> 24][h],
+                                                      &decision[1][h]);
+            }
+            decisions[t][2*j] = packAvx2(decision[0][0], decision[0][1]);
+            decisions[t][2*j + 1] = packAvx2(decision[1][0], decision[1][1]);
+        }
+        current = current ^ 1;
+    }
+    for(state = 0; state < S; state = state + 1)
+    {
+        _mm256_storeu_si256((__m256i *)metric[state], buffer[current][state][0]);
+        _mm256_storeu_si256((__m256i *)(metric[state] + 16), buffer[current][state][1]);
+    }
+}
+
+/**
+ * @brief реализация шагов ACS на AVX-512BW (см. tAcsRun)
+ */
+__attribute__((target("avx512f,avx512bw")))
+static void acsRunAvx512(uint16_t metric[S], const uint16_t (*branch)[1 << N], unsigned int steps,
+                         uint64_t *decisions)
+{
+    static const uint16_t duplicate[2][32] =               //номера метрик state/2 для состояний подряд
+    {
+        { 0,  0,  1,  1,  2,  2,  3,  3,  4,  4,  5,  5,  6,  6,  7,  7,
+          8,  8,  9,  9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15},
+        {16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 21, 22, 22, 23, 23,
+         24, 24, 25, 25, 26, 26, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31}
+    };
+    __m512i lower = _mm512_loadu_si512(duplicate[0]);
+    __m512i upper = _mm512_loadu_si512(duplicate[1]);
+    __m512i index00 = _mm512_loadu_si512(branchIndexTable[0]);
+    __m512i index01 = _mm512_loadu_si512(branchIndexTable[0] + 32);
+    __m512i index10 = _mm512_loadu_si512(branchIndexTable[1]);
+    __m512i index11 = _mm512_loadu_si512(branchIndexTable[1] + 32);
+    __m512i low = _mm512_loadu_si512(metric);               //метрики состояний 0..S/2-1
+    __m512i high = _mm512_loadu_si512(metric + S/2);        //метрики состояний S/2..S-1
+    unsigned int t;
+
+    for(t = 0; t < steps; t = t + 1)
+    {
+        __m512i table = _mm512_broadcast_i32x4(branchTable(branch[t]));
+        __m512i metric0 = _mm512_add_epi16(_mm512_permutexvar_epi16(lower, low), _mm512_shuffle_epi8(table, index00));
+        __m512i metric1 = _mm512_add_epi16(_mm512_permutexvar_epi16(lower, high), _mm512_shuffle_epi8(table, index10));
+        __m512i metric2 = _mm512_add_epi16(_mm512_permutexvar_epi16(upper, low), _mm512_shuffle_epi8(table, index01));
+        __m512i metric3 = _mm512_add_epi16(_mm512_permutexvar_epi16(upper, high), _mm512_shuffle_epi8(table, index11));
+        __mmask32 decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(metric0, metric1), _mm512_setzero_si512());
+        __mmask32 decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(metric2, metric3), _mm512_setzero_si512());
+        low = _mm512_mask_blend_epi16(decision0, metric0, metric1);
+        high = _mm512_mask_blend_epi16(decision1, metric2, metric3);
+        decisions[t] = decision0 | ((uint64_t)decision1 << 32);
+    }
+    _mm512_storeu_si512(metric, low);
+    _mm512_storeu_si512(metric + S/2, high);
+}
+
+/**
+ * @brief пакетная реализация шагов ACS на AVX-512BW (см. tAcsBatchRun): регистр
+ *        содержит метрики одного состояния во всех ACS_LANES кадрах, маска
+ *        сравнения сразу является словом решений состояния
+ */
+__attribute__((target("avx512f,avx512bw")))
+static void acsBatchRunAvx512(uint16_t metric[S][ACS_LANES], const uint16_t (*branch)[1 << N][ACS_LANES],
+                              unsigned int steps, uint32_t (*decisions)[S])
+{
+    __m512i buffer[2][S];                                   //метрики путей до и после шага
+    uint32_t codes[S/2];                                    //коды ветвей пар состояний
+    unsigned int current = 0;                               //индекс актуальных метрик
+    unsigned int state, t, j;
+    batchCodes(codes);
+    for(state = 0; state < S; state = state + 1)
+    {
+        buffer[current][state] = _mm512_loadu_si512(metric[state]);
+    }
+
+    for(t = 0; t < steps; t = t + 1)
+    {
+        const __m512i *oldMetric = buffer[current];
+        __m512i *newMetric = buffer[current ^ 1];
+        __m512i value[1 << N];                              //метрики ветвей кодов 0..3 по кадрам
+        for(j = 0; j < (1 << N); j = j + 1)
+        {
+            value[j] = _mm512_loadu_si512(branch[t][j]);
+        }
+        for(j = 0; j < S/2; j = j + 1)
+        {
+            uint32_t code = codes[j];
+            __m512i low = oldMetric[j];
+            __m512i high = oldMetric[j + S/2];
+            __m512i metric0 = _mm512_add_epi16(low, value[code & 0xFF]);
+            __m512i metric1 = _mm512_add_epi16(high, value[(code >> 8) & 0xFF]);
+            __m512i metric2 = _mm512_add_epi16(low, value[(code >> 16) & 0xFF]);
+            __m512i metric3 = _mm512_add_epi16(high, value[code >> 24]);
+            __mmask32 decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(metric0, metric1), _mm512_setzero_si512());
+            __mmask32 decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(metric2, metric3), _mm512_setzero_si512());
+            newMetric[2*j] = _mm512_mask_blend_epi16(decision0, metric0, metric1);
+            newMetric[2*j + 1] = _mm512_mask_blend_epi16(decision1, metric2, metric3);
+            decisions[t][2*j] = decision0;
+            decisions[t][2*j + 1] = decision1;
+        }
+        current = current ^ 1;
+    }
+    for(state = 0; state < S; state = state + 1)
+    {
+        _mm512_storeu_si512(metric[state], buffer[current][state]);
+    }
+}
+
+/**
+ * @brief выбор наилучшей реализации шагов ACS при загрузке программы
+ * @param
+ */
+__attribute__((constructor))
+static void acsDetect(void)
+{
+    __builtin_cpu_init();                                   //конструктор может выполняться до инициализации libgcc
+    if(!acsSelect(ACS_AVX512) && !acsSelect(ACS_AVX2))
+    {
+        acsSelect(ACS_SSE2);
+    }
+}
+#endif
+
+/**
+ * @brief проверка поддержки реализации шагов ACS процессором
+ * @param
+ *  kernel - реализация
+ */
+bool acsSupported(eAcsKernel kernel)
+{
+    switch(kernel)
+    {
+    case ACS_SCALAR:
+        return true;
+#ifdef ACS_X86
+    case ACS_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case ACS_AVX2:
+        return __builtin_cpu_supports("avx2");
+    case ACS_AVX512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief выбор реализации шагов ACS
+ * @param
+ *  kernel - реализация
+ * @return true, если реализация поддерживается и выбрана
+ */
+bool acsSelect(eAcsKernel kernel)
+{
+    static const tAcsRun kernels[ACS_KERNELS] =             //реализации в порядке eAcsKernel
+    {
+        acsRunScalar,
+#ifdef ACS_X86
+        acsRunSse2, acsRunAvx2, acsRunAvx512
+#endif
+    };
+    static const tAcsBatchRun batchKernels[ACS_KERNELS] =   //пакетные реализации: для SSE2 - скалярная
+    {
+        acsBatchRunScalar,
+#ifdef ACS_X86
+        acsBatchRunScalar, acsBatchRunAvx2, acsBatchRunAvx512
+#endif
+    };
+    if(!acsSupported(kernel))
+    {
+        return false;
+    }
+    acsRun = kernels[kernel];
+    acsBatchRun = batchKernels[kernel];
+    currentKernel = kernel;
+    return true;
+}
+
+/**
+ * @brief текущая реализация шагов ACS
+ * @param
+ */
+eAcsKernel acsKernel(void)
+{
+    return currentKernel;
+}
+
+/**
+ * @brief название реализации шагов ACS
+ * @param
+ *  kernel - реализация
+ */
+const char *acsKernelName(eAcsKernel kernel)
+{
+    static const char *names[ACS_KERNELS] = {"scalar", "SSE2", "AVX2", "AVX-512"};
+    return (kernel < ACS_KERNELS) ? names[kernel] : "unknown";
+}
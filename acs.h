@@ -0,0 +1,131 @@
+/********************************************************************************
+* @file    acs.h
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Файл описывает шаги сложения-сравнения-выбора (ACS) декодера Витерби для
+  * решетки из S состояний и их векторные реализации (SSE2, AVX2, AVX-512).
+  * Реализация выбирается при загрузке программы по возможностям процессора;
+  * все реализации дают одинаковые метрики и решения. Пакетные реализации
+  * (tAcsBatchRun) выполняют шаги для ACS_LANES независимых кадров, по кадру
+  * на элемент вектора
+  *
+  ******************************************************************************
+*/
+
+#ifndef ACS
+#define ACS
+
+#include <stdbool.h>
+#include "tables.h"
+
+//*******************************Макросы******************************************
+/**
+ * @brief количество кадров, обрабатываемых пакетной реализацией шагов ACS
+ *        одновременно (решения состояния по всем кадрам - в uint32_t)
+ */
+#define ACS_LANES 32
+
+//*****************************Перечисления****************************************
+/**
+ * @brief реализации шагов ACS
+ *  ACS_SCALAR - скалярная
+ *  ACS_SSE2 - SSE2, 8 состояний на регистр
+ *  ACS_AVX2 - AVX2, 16 состояний на регистр
+ *  ACS_AVX512 - AVX-512BW, 32 состояния на регистр
+ */
+typedef enum
+{
+    ACS_SCALAR,
+    ACS_SSE2,
+    ACS_AVX2,
+    ACS_AVX512,
+    ACS_KERNELS
+}eAcsKernel;
+
+//*****************************Типы**********************************************
+/**
+ * @brief шаги сложения-сравнения-выбора для всех S состояний.
+ *        В состояние state ведут переходы из состояний state/2 и state/2 + S/2
+ *        по входному символу state & 1. Метрики хранятся по модулю 2^16 и
+ *        сравниваются по знаку разности, поэтому нормировка не нужна. Между
+ *        шагами метрики остаются в регистрах
+ * @param
+ *  metric - метрики путей до первого шага, после выполнения - после последнего
+ *  branch - метрики ветвей шагов, 2^N элементов на шаг
+ *  steps - количество шагов
+ *  decisions - решения шагов: бит state равен 1, если выжил путь из state/2 + S/2
+ */
+typedef void (*tAcsRun)(uint16_t metric[S], const uint16_t (*branch)[1 << N], unsigned int steps,
+                        uint64_t *decisions);
+
+/**
+ * @brief шаги сложения-сравнения-выбора для ACS_LANES независимых кадров.
+ *        Правила сравнения и выбора как в tAcsRun; элемент lane всех массивов
+ *        относится к кадру lane
+ * @param
+ *  metric - метрики путей до первого шага, после выполнения - после последнего
+ *  branch - метрики ветвей шагов: branch[t][code][lane]
+ *  steps - количество шагов
+ *  decisions - решения шагов: бит lane элемента decisions[t][state] равен 1,
+ *              если в кадре lane выжил путь из state/2 + S/2
+ */
+typedef void (*tAcsBatchRun)(uint16_t metric[S][ACS_LANES], const uint16_t (*branch)[1 << N][ACS_LANES],
+                             unsigned int steps, uint32_t (*decisions)[S]);
+
+//**************************Переменные*******************************************
+/**
+ * @brief текущая реализация шагов ACS (выбирается при загрузке программы,
+ *        см. acsSelect)
+ */
+extern tAcsRun acsRun;
+
+/**
+ * @brief текущая пакетная реализация шагов ACS (выбирается вместе с acsRun)
+ */
+extern tAcsBatchRun acsBatchRun;
+
+//******************************Функции*******************************************
+/**
+ * @brief скалярная реализация шагов ACS (см. tAcsRun)
+ */
+void acsRunScalar(uint16_t metric[S], const uint16_t (*branch)[1 << N], unsigned int steps,
+                  uint64_t *decisions);
+
+/**
+ * @brief скалярная пакетная реализация шагов ACS (см. tAcsBatchRun)
+ */
+void acsBatchRunScalar(uint16_t metric[S][ACS_LANES], const uint16_t (*branch)[1 << N][ACS_LANES],
+                       unsigned int steps, uint32_t (*decisions)[S]);
+
+/**
+ * @brief проверка поддержки реализации шагов ACS процессором
+ * @param
+ *  kernel - реализация
+ */
+bool acsSupported(eAcsKernel kernel);
+
+/**
+ * @brief выбор реализации шагов ACS
+ * @param
+ *  kernel - реализация
+ * @return true, если реализация поддерживается и выбрана
+ */
+bool acsSelect(eAcsKernel kernel);
+
+/**
+ * @brief текущая реализация шагов ACS
+ * @param
+ */
+eAcsKernel acsKernel(void);
+
+/**
+ * @brief название реализации шагов ACS
+ * @param
+ *  kernel - реализация
+ */
+const char *acsKernelName(eAcsKernel kernel);
+
+#endif // ACS
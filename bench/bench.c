@@ -0,0 +1,2132 @@
+/********************************************************************************
+* @file    bench.c
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Файл содержит замеры производительности сверточного кодера и декодера.
+  * Перед каждым замером проверяется, что ускоренный вариант выдает те же
+  * символы, что и исходный; при расхождении программа завершается с кодом 1.
+  *
+  * Сборка (из корня репозитория):
+  *  gcc -std=gnu99 -O2 -pthread -iquote . bench/bench.c coder.c viterby.c tables.c puncture.c acs.c -lm -o bench
+  *
+  ******************************************************************************
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "coder.h"
+#include "viterby.h"
+#include "puncture.h"
+#include "acs.h"
+
+/**
+ * @brief текущее время в секундах
+ * @param
+ */
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief заполнение слова случайными символами 0/1
+ * @param
+ *  word - заполняемое слово
+ *  len - длина слова
+ */
+static void randomWord(unsigned int *word, unsigned int len)
+{
+    unsigned int i;
+    for(i = 0; i < len; i = i + 1)
+    {
+        word[i] = rand() & 1;
+    }
+}
+
+/**
+ * @brief двоичный симметричный канал: каждый символ инвертируется с вероятностью p
+ * @param
+ *  word - передаваемое слово
+ *  len - длина слова
+ *  p - вероятность ошибки в символе
+ */
+static void channel(unsigned int *word, unsigned int len, double p)
+{
+    unsigned int i;
+    for(i = 0; i < len; i = i + 1)
+    {
+        if(rand() < p * RAND_MAX)
+        {
+            word[i] ^= 1;
+        }
+    }
+}
+
+/**
+ * @brief упаковка массива символов по 8 в байт, старший бит первый
+ * @param
+ *  bits - массив символов
+ *  len - количество символов
+ *  reverse - флаг обхода массива с конца (порядок подачи в getCodeWord)
+ *  packed - упакованный массив, не менее (len + 7)/8 байт
+ */
+static void packBits(const unsigned int *bits, unsigned int len, bool reverse, uint8_t *packed)
+{
+    unsigned int i;
+    memset(packed, 0, (len + 7) / 8);
+    for(i = 0; i < len; i = i + 1)
+    {
+        unsigned int bit = reverse ? bits[len - 1 - i] : bits[i];
+        packed[i / 8] |= (bit & 1) << (7 - i % 8);
+    }
+}
+
+/**
+ * @brief распаковка байтов по символу на элемент, старший бит первый
+ * @param
+ *  packed - упакованный массив
+ *  len - количество символов
+ *  reverse - флаг записи массива с конца (порядок getCodeWord/getDecode)
+ *  bits - массив символов, не менее len элементов
+ */
+static void unpackBits(const uint8_t *packed, unsigned int len, bool reverse, unsigned int *bits)
+{
+    unsigned int i;
+    for(i = 0; i < len; i = i + 1)
+    {
+        unsigned int bit = (packed[i / 8] >> (7 - i % 8)) & 1;
+        bits[reverse ? (len - 1 - i) : i] = bit;
+    }
+}
+
+/**
+ * @brief проверка и замер побайтового кодирования относительно getCodeWord
+ * @param
+ */
+static bool benchPackedEncoder(void)
+{
+    unsigned int lens[] = {1, 7, 8, 9, 40, 100, 1023, 4096};   //длины проверочных слов
+    unsigned int t;
+    for(t = 0; t < sizeof(lens) / sizeof(lens[0]); t = t + 1)
+    {
+        unsigned int len = lens[t];
+        unsigned int codeLen = N*(len + SIZE-1);
+        unsigned int *word = malloc(len * sizeof(unsigned int));
+        unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+        uint8_t *packedWord = malloc((len + 7) / 8);
+        uint8_t *expected = malloc((codeLen + 7) / 8);
+        uint8_t *packedCode = malloc((codeLen + 7) / 8);
+
+        randomWord(word, len);
+        getCodeWord(word, len, code, codeLen);
+        packBits(code, codeLen, false, expected);           //ожидаемое кодовое слово (сброс регистра и SIZE-1 нулей в конце)
+        packBits(word, len, true, packedWord);              //getCodeWord подает символы с конца слова
+        getCodeWordPacked(packedWord, len, packedCode);
+        bool same = !memcmp(expected, packedCode, (codeLen + 7) / 8);
+
+        free(word); free(code); free(packedWord); free(expected); free(packedCode);
+        if(!same)
+        {
+            printf("getCodeWordPacked: mismatch for wordLen = %u\n", len);
+            return false;
+        }
+    }
+
+    unsigned int len = 1 << 22;                             //длина слова для замера
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    uint8_t *packedWord = malloc(len / 8);
+    uint8_t *packedCode = malloc((codeLen + 7) / 8);
+    randomWord(word, len);
+    packBits(word, len, true, packedWord);
+
+    double start = now();
+    getCodeWord(word, len, code, codeLen);
+    double bitTime = now() - start;
+
+    start = now();
+    getCodeWordPacked(packedWord, len, packedCode);
+    double byteTime = now() - start;
+
+    printf("encoder  getCodeWord        %8.1f Mbit/s\n", len / bitTime * 1e-6);
+    printf("encoder  getCodeWordPacked  %8.1f Mbit/s  (x%.1f)\n", len / byteTime * 1e-6, bitTime / byteTime);
+
+    free(word); free(code); free(packedWord); free(packedCode);
+    return true;
+}
+
+/**
+ * @brief проверка и замер битово-параллельного кодирования относительно getCodeWord
+ * @param
+ *  width - количество 64-разрядных слов на символ (64*width независимых слов)
+ */
+static bool benchSlicedEncoder(unsigned int width)
+{
+    unsigned int count = 64 * width;                        //количество независимых слов
+    unsigned int len = 4096;                                //длина каждого слова
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int **words = malloc(count * sizeof(unsigned int *));
+    unsigned int **codes = malloc(count * sizeof(unsigned int *));
+    unsigned int **sliceCodes = malloc(count * sizeof(unsigned int *));
+    uint64_t *sliced = malloc(len * width * sizeof(uint64_t));
+    uint64_t *slicedCode = malloc(codeLen * width * sizeof(uint64_t));
+    unsigned int i;
+    for(i = 0; i < count; i = i + 1)
+    {
+        words[i] = malloc(len * sizeof(unsigned int));
+        codes[i] = malloc(codeLen * sizeof(unsigned int));
+        sliceCodes[i] = malloc(codeLen * sizeof(unsigned int));
+        randomWord(words[i], len);
+    }
+
+    double start = now();
+    for(i = 0; i < count; i = i + 1)
+    {
+        getCodeWord(words[i], len, codes[i], codeLen);
+    }
+    double serialTime = now() - start;
+
+    start = now();
+    slicedPack(words, count, len, width, sliced);
+    double packTime = now() - start;
+    start = now();
+    bool encoded = getCodeWordSliced(sliced, len, width, slicedCode, codeLen);
+    double sliceTime = now() - start;
+    start = now();
+    slicedUnpack(slicedCode, codeLen, width, sliceCodes, count);
+    double unpackTime = now() - start;
+
+    bool same = true;
+    for(i = 0; i < count; i = i + 1)
+    {
+        same = same && !memcmp(codes[i], sliceCodes[i], codeLen * sizeof(unsigned int));
+        free(words[i]); free(codes[i]); free(sliceCodes[i]);
+    }
+    free(words); free(codes); free(sliceCodes); free(sliced); free(slicedCode);
+    if(!encoded)
+    {
+        printf("getCodeWordSliced: out of memory\n");
+        return false;
+    }
+    if(!same)
+    {
+        printf("getCodeWordSliced: mismatch for width = %u\n", width);
+        return false;
+    }
+
+    double bits = (double)count * len;
+    printf("encoder  getCodeWord x%-3u      %8.1f Mbit/s\n", count, bits / serialTime * 1e-6);
+    printf("encoder  getCodeWordSliced/%u  %8.1f Mbit/s  (x%.1f, with pack/unpack %8.1f Mbit/s)\n",
+           width, bits / sliceTime * 1e-6, serialTime / sliceTime,
+           bits / (packTime + sliceTime + unpackTime) * 1e-6);
+    return true;
+}
+
+/**
+ * @brief проверка и замер масштабирования параллельного кодирования от 1 до N ядер
+ * @param
+ */
+static bool benchParallelEncoder(void)
+{
+    unsigned int cores = sysconf(_SC_NPROCESSORS_ONLN);     //количество доступных ядер
+    unsigned int t;
+
+    unsigned int len = 100003;                              //проверка на слове, не кратном размеру участка
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *parallelCode = malloc(codeLen * sizeof(unsigned int));
+    uint8_t *packedWord = malloc((len + 7) / 8);
+    uint8_t *packedCode = malloc((codeLen + 7) / 8);
+    uint8_t *parallelPacked = malloc((codeLen + 7) / 8);
+    randomWord(word, len);
+    packBits(word, len, true, packedWord);
+    getCodeWord(word, len, code, codeLen);
+    getCodeWordPacked(packedWord, len, packedCode);
+    bool same = true;
+    for(t = 1; t <= 4; t = t + 1)
+    {
+        getCodeWordParallel(word, len, parallelCode, codeLen, t, 997);
+        getCodeWordPackedParallel(packedWord, len, parallelPacked, t, 125);
+        same = same && !memcmp(code, parallelCode, codeLen * sizeof(unsigned int))
+                    && !memcmp(packedCode, parallelPacked, (codeLen + 7) / 8);
+    }
+    free(word); free(code); free(parallelCode); free(packedWord); free(packedCode); free(parallelPacked);
+    if(!same)
+    {
+        printf("getCodeWordParallel: mismatch\n");
+        return false;
+    }
+
+    len = 1u << 28;                                         //256 Мбит для замера
+    codeLen = N*(len + SIZE-1);
+    packedWord = malloc(len / 8);
+    parallelPacked = malloc((codeLen + 7) / 8);
+    for(t = 0; t < len / 8; t = t + 1)
+    {
+        packedWord[t] = rand() & 0xFF;
+    }
+    double single = 0;
+    for(t = 1; t <= cores; t = t + 1)
+    {
+        double start = now();
+        getCodeWordPackedParallel(packedWord, len, parallelPacked, t, 1 << 20);
+        double elapsed = now() - start;
+        if(t == 1)
+        {
+            single = elapsed;
+        }
+        printf("encoder  getCodeWordPackedParallel threads=%-3u %8.1f Mbit/s  (x%.2f)\n",
+               t, len / elapsed * 1e-6, single / elapsed);
+    }
+    free(packedWord); free(parallelPacked);
+    return true;
+}
+
+/**
+ * @brief проверка потокового кодера (кодирование частями равно кодированию
+ *        целиком) и замер кодирования коротких пакетов
+ * @param
+ */
+static bool benchStreamEncoder(void)
+{
+    unsigned int len = 10000;                               //длина потока для проверки
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *stream = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *chunked = malloc(codeLen * sizeof(unsigned int));
+    uint8_t *packedWord = malloc(len / 8);
+    uint8_t *packedCode = malloc((codeLen + 7) / 8);
+    uint8_t *packedChunked = malloc((codeLen + 7) / 8 + 1);
+    unsigned int i;
+    randomWord(word, len);
+    for(i = 0; i < len; i = i + 1)
+    {
+        stream[i] = word[len - 1 - i];                      //getCodeWord подает символы с конца слова
+    }
+    packBits(word, len, true, packedWord);
+    getCodeWord(word, len, code, codeLen);
+    getCodeWordPacked(packedWord, len, packedCode);
+
+    sCoder coder;
+    coderInit(&coder);
+    unsigned int pos = 0;                                   //позиция в потоке
+    unsigned int j = 0;                                     //позиция в кодовом слове
+    while(pos < len)
+    {
+        unsigned int part = 1 + rand() % 97;                //части произвольной длины
+        if(part > len - pos)
+        {
+            part = len - pos;
+        }
+        j = j + coderPush(&coder, stream + pos, part, chunked + j);
+        pos = pos + part;
+    }
+    coderFlush(&coder, chunked + j);
+
+    pos = 0;
+    j = 0;
+    while(pos < len / 8)
+    {
+        unsigned int part = 1 + rand() % 13;
+        if(part > len / 8 - pos)
+        {
+            part = len / 8 - pos;
+        }
+        j = j + coderPushPacked(&coder, packedWord + pos, part, packedChunked + j);
+        pos = pos + part;
+    }
+    coderFlushPacked(&coder, packedChunked + j);
+
+    bool same = !memcmp(code, chunked, codeLen * sizeof(unsigned int))
+             && !memcmp(packedCode, packedChunked, (codeLen + 7) / 8);
+    free(word); free(stream); free(code); free(chunked);
+    free(packedWord); free(packedCode); free(packedChunked);
+    if(!same)
+    {
+        printf("coderPush: chunked encoding differs from one-shot encoding\n");
+        return false;
+    }
+
+    unsigned int packets = 1 << 20;                         //количество пакетов по 8 байт
+    unsigned int packetBytes = 8;
+    uint8_t packet[8];
+    uint8_t out[N*8 + 2];
+    for(i = 0; i < packetBytes; i = i + 1)
+    {
+        packet[i] = rand() & 0xFF;
+    }
+    double start = now();
+    for(i = 0; i < packets; i = i + 1)
+    {
+        packet[0] = i;
+        getCodeWordPacked(packet, 8*packetBytes, out);
+    }
+    double frameTime = now() - start;
+    start = now();
+    for(i = 0; i < packets; i = i + 1)
+    {
+        packet[0] = i;
+        coderPushPacked(&coder, packet, packetBytes, out);
+    }
+    double pushTime = now() - start;
+    printf("encoder  64-bit packets: getCodeWordPacked %6.1f ns/packet, coderPushPacked %6.1f ns/packet\n",
+           frameTime / packets * 1e9, pushTime / packets * 1e9);
+    return true;
+}
+
+/**
+ * @brief сравнение декодера Витерби со сложением-сравнением-выбором (getDecode)
+ *        с исходным поиском по дереву (getDecodeTree) на одних и тех же
+ *        зашумленных кадрах и замер скорости getDecode на длинных словах
+ * @param
+ */
+static bool benchDecoder(void)
+{
+    unsigned int lens[] = {40, 56};                         //длины кадров (поиск по дереву ограничен S последовательностями)
+    double errors[] = {0.0, 0.01, 0.03};                    //вероятности ошибки в канале
+    unsigned int frames = 2000;                             //количество кадров на точку
+    unsigned int l, e, f, i;
+    for(l = 0; l < sizeof(lens) / sizeof(lens[0]); l = l + 1)
+    {
+        unsigned int len = lens[l];
+        unsigned int codeLen = N*(len + SIZE-1);
+        unsigned int word[64], decoded[64];
+        unsigned int code[N*(64 + SIZE)], noisy[N*(64 + SIZE)];
+        for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+        {
+            unsigned int treeFail = 0, acsFail = 0;         //количество ошибочно декодированных кадров
+            unsigned int treeBits = 0, acsBits = 0;         //количество ошибочно декодированных символов
+            double treeTime = 0, acsTime = 0;
+            for(f = 0; f < frames; f = f + 1)
+            {
+                randomWord(word, len);
+                getCodeWord(word, len, code, codeLen);
+                channel(code, codeLen, errors[e]);
+
+                memcpy(noisy, code, codeLen * sizeof(unsigned int));
+                double start = now();
+                getDecodeTree(noisy, codeLen, decoded, len);
+                treeTime += now() - start;
+                treeFail += memcmp(word, decoded, len * sizeof(unsigned int)) != 0;
+                for(i = 0; i < len; i = i + 1)
+                {
+                    treeBits += word[i] != decoded[i];
+                }
+
+                memcpy(noisy, code, codeLen * sizeof(unsigned int));
+                start = now();
+                getDecode(noisy, codeLen, decoded, len);
+                acsTime += now() - start;
+                acsFail += memcmp(word, decoded, len * sizeof(unsigned int)) != 0;
+                for(i = 0; i < len; i = i + 1)
+                {
+                    acsBits += word[i] != decoded[i];
+                }
+            }
+            if((errors[e] == 0) && (acsFail > 0))
+            {
+                printf("getDecode: %u clean frames decoded wrongly\n", acsFail);
+                return false;
+            }
+            printf("decoder len=%-3u p=%.2f  tree %7.2f us/frame FER %.3f BER %.4f | "
+                   "ACS %6.2f us/frame FER %.3f BER %.4f\n",
+                   len, errors[e], treeTime / frames * 1e6, (double)treeFail / frames,
+                   (double)treeBits / (frames * len), acsTime / frames * 1e6, (double)acsFail / frames,
+                   (double)acsBits / (frames * len));
+        }
+    }
+
+    unsigned int len = 100000;                              //длина слова для замера скорости
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *decoded = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    double rates[] = {0.0, 0.05};
+    for(e = 0; e < 2; e = e + 1)
+    {
+        randomWord(word, len);
+        getCodeWord(word, len, code, codeLen);
+        channel(code, codeLen, rates[e]);
+        double start = now();
+        getDecode(code, codeLen, decoded, len);
+        double time = now() - start;
+        unsigned int bitErrors = 0;
+        for(i = 0; i < len; i = i + 1)
+        {
+            bitErrors += word[i] != decoded[i];
+        }
+        printf("decoder ACS len=%u p=%.2f  %6.2f Mbit/s  BER %.5f\n",
+               len, rates[e], len / time * 1e-6, (double)bitErrors / len);
+        if((rates[e] == 0) && bitErrors)
+        {
+            printf("getDecode: clean word decoded wrongly\n");
+            return false;
+        }
+    }
+    free(word);
+    free(decoded);
+    free(code);
+    return true;
+}
+
+/**
+ * @brief проверка совпадения векторных реализаций шага ACS со скалярной и
+ *        замер скорости шага ACS и декодера getDecode для каждой реализации
+ * @param
+ */
+static bool benchAcs(void)
+{
+    eAcsKernel detected = acsKernel();                      //реализация, выбранная при загрузке
+    uint16_t scalarMetric[S], vectorMetric[S];
+    uint64_t scalarDecisions[16], vectorDecisions[16];
+    unsigned int len = 200000;                              //длина слова для замера скорости
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *decoded = malloc(len * sizeof(unsigned int));
+    unsigned int *reference = malloc(len * sizeof(unsigned int));
+    uint16_t (*branch)[1 << N] = malloc(len * sizeof(*branch));
+    uint64_t *decisions = malloc(len * sizeof(uint64_t));
+    unsigned int kernel, i, r;
+
+    initTables();
+    randomWord(word, len);
+    getCodeWord(word, len, code, codeLen);
+    channel(code, codeLen, 0.03);
+    acsSelect(ACS_SCALAR);
+    getDecode(code, codeLen, reference, len);
+    for(i = 0; i < len; i = i + 1)
+    {
+        unsigned int c;
+        for(c = 0; c < (1 << N); c = c + 1)
+        {
+            branch[i][c] = rand() % (N + 1);
+        }
+    }
+
+    printf("acs      detected kernel: %s\n", acsKernelName(detected));
+    for(kernel = 0; kernel < ACS_KERNELS; kernel = kernel + 1)
+    {
+        if(!acsSelect(kernel))
+        {
+            printf("acs      %-8s not supported\n", acsKernelName(kernel));
+            continue;
+        }
+        for(r = 0; r < 20000; r = r + 1)                    //случайные метрики во всем диапазоне по модулю 2^16
+        {
+            uint16_t random[16][1 << N];
+            for(i = 0; i < S; i = i + 1)
+            {
+                scalarMetric[i] = (r & 1) ? rand() : (rand() % 64);
+                vectorMetric[i] = scalarMetric[i];
+            }
+            for(i = 0; i < 16 * (1 << N); i = i + 1)
+            {
+                random[i >> N][i & ((1 << N) - 1)] = (r & 2) ? rand() : (rand() % (N + 1));
+            }
+            acsRunScalar(scalarMetric, random, 16, scalarDecisions);
+            acsRun(vectorMetric, random, 16, vectorDecisions);
+            if(memcmp(scalarDecisions, vectorDecisions, sizeof(scalarDecisions))
+               || memcmp(scalarMetric, vectorMetric, sizeof(scalarMetric)))
+            {
+                printf("acs %s: mismatch with scalar kernel\n", acsKernelName(kernel));
+                return false;
+            }
+        }
+
+        double start = now();
+        acsRun(vectorMetric, branch, len, decisions);
+        double acsTime = now() - start;
+
+        start = now();
+        getDecode(code, codeLen, decoded, len);
+        double decodeTime = now() - start;
+        if(memcmp(decoded, reference, len * sizeof(unsigned int)))
+        {
+            printf("getDecode %s: mismatch with scalar kernel\n", acsKernelName(kernel));
+            return false;
+        }
+        printf("acs      %-8s ACS step %6.2f ns (%7.2f Mbit/s)  getDecode %7.2f Mbit/s\n",
+               acsKernelName(kernel), acsTime / len * 1e9, len / acsTime * 1e-6, len / decodeTime * 1e-6);
+    }
+    acsSelect(detected);
+    free(word);
+    free(code);
+    free(decoded);
+    free(reference);
+    free(branch);
+    free(decisions);
+    return true;
+}
+
+/**
+ * @brief нормально распределенная случайная величина (метод Бокса-Мюллера)
+ * @param
+ */
+static double gaussian(void)
+{
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/**
+ * @brief кривые BER от Eb/N0 (BPSK, аддитивный белый гауссов шум) и скорость
+ *        декодирования для жестких решений, квантованных символов (3 и 4 разряда)
+ *        и мягких решений int8 LLR
+ * @param
+ */
+static bool benchSoft(void)
+{
+    unsigned int len = 20000;                               //длина слова
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int frames = 10;                               //количество слов на точку
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *decoded = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *hard = malloc(codeLen * sizeof(unsigned int));
+    uint8_t *q3 = malloc(codeLen), *q4 = malloc(codeLen), *q1 = malloc(codeLen);
+    int8_t *llr = malloc(codeLen);
+    unsigned int ebn0, f, i;
+
+    printf("soft     Eb/N0  channel    hard       3-bit      4-bit      int8 LLR\n");
+    for(ebn0 = 0; ebn0 <= 6; ebn0 = ebn0 + 1)
+    {
+        double sigma = sqrt(1.0 / (2.0 * 0.5 * pow(10.0, ebn0 / 10.0)));    //шум при скорости кода 1/2
+        unsigned int errors[5] = {0};                       //ошибки в канале, hard, 3, 4 разряда, LLR
+        for(f = 0; f < frames; f = f + 1)
+        {
+            randomWord(word, len);
+            getCodeWord(word, len, code, codeLen);
+            for(i = 0; i < codeLen; i = i + 1)
+            {
+                double y = (code[i] ? -1.0 : 1.0) + sigma * gaussian();    //0 -> +1, 1 -> -1
+                double q = (1.0 - y) / 2.0;                 //0 для уверенного 0, 1 для уверенной 1
+                int l = (int)lrint(y * 32.0);               //масштаб LLR не влияет на решения декодера
+                hard[i] = y < 0;
+                q1[i] = hard[i];
+                q3[i] = (q <= 0) ? 0 : (q >= 1) ? 7 : (uint8_t)lrint(q * 7);
+                q4[i] = (q <= 0) ? 0 : (q >= 1) ? 15 : (uint8_t)lrint(q * 15);
+                llr[i] = (l > 127) ? 127 : (l < -127) ? -127 : l;
+                errors[0] += hard[i] != code[i];
+            }
+            getDecode(hard, codeLen, decoded, len);
+            for(i = 0; i < len; i = i + 1)
+            {
+                errors[1] += decoded[i] != word[i];
+            }
+            unsigned int *check = malloc(len * sizeof(unsigned int));
+            getDecodeQuantized(q1, codeLen, 1, check, len);  //один разряд - те же жесткие решения
+            if(memcmp(check, decoded, len * sizeof(unsigned int)))
+            {
+                printf("getDecodeQuantized: 1-bit result differs from getDecode\n");
+                return false;
+            }
+            free(check);
+            getDecodeQuantized(q3, codeLen, 3, decoded, len);
+            for(i = 0; i < len; i = i + 1)
+            {
+                errors[2] += decoded[i] != word[i];
+            }
+            getDecodeQuantized(q4, codeLen, 4, decoded, len);
+            for(i = 0; i < len; i = i + 1)
+            {
+                errors[3] += decoded[i] != word[i];
+            }
+            getDecodeSoft(llr, codeLen, decoded, len);
+            for(i = 0; i < len; i = i + 1)
+            {
+                errors[4] += decoded[i] != word[i];
+            }
+        }
+        printf("soft     %2u dB  %.2e   %.2e   %.2e   %.2e   %.2e\n", ebn0,
+               (double)errors[0] / (frames * codeLen), (double)errors[1] / (frames * len),
+               (double)errors[2] / (frames * len), (double)errors[3] / (frames * len),
+               (double)errors[4] / (frames * len));
+        if((ebn0 == 6) && (errors[4] > errors[1]))
+        {
+            printf("getDecodeSoft: worse than hard decisions at 6 dB\n");
+            return false;
+        }
+    }
+
+    unsigned int repeat = 20, r;
+    double start = now();
+    for(r = 0; r < repeat; r = r + 1)
+    {
+        getDecode(hard, codeLen, decoded, len);
+    }
+    double hardTime = (now() - start) / repeat;
+    start = now();
+    for(r = 0; r < repeat; r = r + 1)
+    {
+        getDecodeQuantized(q3, codeLen, 3, decoded, len);
+    }
+    double q3Time = (now() - start) / repeat;
+    start = now();
+    for(r = 0; r < repeat; r = r + 1)
+    {
+        getDecodeSoft(llr, codeLen, decoded, len);
+    }
+    double llrTime = (now() - start) / repeat;
+    printf("soft     throughput: hard %.2f Mbit/s, 3-bit %.2f Mbit/s, int8 LLR %.2f Mbit/s\n",
+           len / hardTime * 1e-6, len / q3Time * 1e-6, len / llrTime * 1e-6);
+
+    free(word);
+    free(decoded);
+    free(code);
+    free(hard);
+    free(q1);
+    free(q3);
+    free(q4);
+    free(llr);
+    return true;
+}
+
+/**
+ * @brief проверка и замер потокового декодера: поток кодируется coderPush
+ *        частями случайной длины и декодируется decoderPush частями случайной
+ *        (в том числе нечетной) длины. Результат сравнивается с getDecode
+ * @param
+ */
+static bool benchStreamDecoder(void)
+{
+    unsigned int len = 200000;                              //длина потока
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int depths[] = {SIZE + 1, 2*(SIZE + 1), DECODER_DEPTH, 2*DECODER_DEPTH};
+    double errors[] = {0.0, 0.03};
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *decoded = malloc((len + 2*DECODER_MAX_DEPTH) * sizeof(unsigned int));
+    unsigned int *reference = malloc(len * sizeof(unsigned int));
+    unsigned int d, e, i;
+    sCoder coder;
+    sDecoder decoder;
+
+    randomWord(word, len);
+    coderInit(&coder);
+    unsigned int written = 0;
+    while(written < N*len)
+    {
+        unsigned int part = 1 + rand() % 3000;
+        if(written/N + part > len)
+        {
+            part = len - written/N;
+        }
+        written += coderPush(&coder, word + written/N, part, code + written);
+    }
+    written += coderFlush(&coder, code + written);
+    if(written != codeLen)
+    {
+        printf("decoderPush: stream encoding length mismatch\n");
+        return false;
+    }
+
+    for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+    {
+        unsigned int *noisy = malloc(codeLen * sizeof(unsigned int));
+        memcpy(noisy, code, codeLen * sizeof(unsigned int));
+        channel(noisy, codeLen, errors[e]);
+        getDecode(noisy, codeLen, reference, len);
+        unsigned int referenceErrors = 0;
+        for(i = 0; i < len; i = i + 1)
+        {
+            referenceErrors += reference[len - 1 - i] != word[i];   //getDecode выдает слово в обратном порядке
+        }
+        for(d = 0; d < sizeof(depths) / sizeof(depths[0]); d = d + 1)
+        {
+            decoderInit(&decoder, depths[d]);
+            unsigned int got = 0, consumed = 0;
+            double start = now();
+            while(consumed < codeLen)
+            {
+                unsigned int part = 1 + rand() % 5001;      //части любой длины, в том числе нечетной
+                if(consumed + part > codeLen)
+                {
+                    part = codeLen - consumed;
+                }
+                got += decoderPush(&decoder, noisy + consumed, part, decoded + got);
+                consumed += part;
+            }
+            got += decoderFlush(&decoder, decoded + got);
+            double time = now() - start;
+            if(got != len)
+            {
+                printf("decoderPush: %u symbols decoded instead of %u\n", got, len);
+                return false;
+            }
+            unsigned int bitErrors = 0;
+            for(i = 0; i < len; i = i + 1)
+            {
+                bitErrors += decoded[i] != word[i];
+            }
+            if((errors[e] == 0) && bitErrors)
+            {
+                printf("decoderPush: clean stream decoded with %u errors\n", bitErrors);
+                return false;
+            }
+            printf("stream decoder depth=%-3u p=%.2f  %7.2f Mbit/s  BER %.5f (getDecode %.5f)  "
+                   "latency <= %u steps  context %u bytes\n",
+                   depths[d], errors[e], len / time * 1e-6, (double)bitErrors / len,
+                   (double)referenceErrors / len, 2*depths[d], (unsigned int)sizeof(sDecoder));
+        }
+        free(noisy);
+    }
+    free(word);
+    free(code);
+    free(decoded);
+    free(reference);
+    return true;
+}
+
+/**
+ * @brief приемник символов потокового декодера для замера задержки: для
+ *        каждого символа запоминается шаг потока, на котором он выдан
+ */
+typedef struct
+{
+    unsigned int *bits;                                     //выданные символы
+    unsigned int *latency;                                  //задержка выдачи символов в шагах
+    unsigned int count;                                     //количество выданных символов
+    unsigned int step;                                      //количество поданных шагов
+}sEarlySink;
+
+/**
+ * @brief функция получения символов декодера (см. tDecoderOutput)
+ */
+static void earlySink(void *context, const unsigned int *bits, unsigned int count)
+{
+    sEarlySink *sink = context;
+    unsigned int i;
+    for(i = 0; i < count; i = i + 1)
+    {
+        sink->bits[sink->count] = bits[i];
+        sink->latency[sink->count] = sink->step - sink->count;
+        sink->count = sink->count + 1;
+    }
+}
+
+/**
+ * @brief сравнение задержек для qsort
+ */
+static int compareLatency(const void *a, const void *b)
+{
+    unsigned int x = *(const unsigned int *)a, y = *(const unsigned int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief замер задержки выдачи символов потокового декодера: поток подается
+ *        по одному шагу (N символов), задержка символа - разность шагов выдачи
+ *        и поступления. Режим ранних решений сравнивается с выдачей по
+ *        заполнению буфера той же глубины (DECODER_DEPTH)
+ * @param
+ */
+static bool benchEarly(void)
+{
+    unsigned int len = 200000;                              //длина потока
+    unsigned int codeLen = N*(len + SIZE-1);
+    double errors[] = {0.0, 0.03};
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *noisy = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *reference = malloc(len * sizeof(unsigned int));
+    unsigned int *output = malloc(2*DECODER_MAX_DEPTH * sizeof(unsigned int));
+    sEarlySink sink;
+    unsigned int e, mode, i;
+    sCoder coder;
+    sDecoder decoder;
+
+    sink.bits = malloc(len * sizeof(unsigned int));
+    sink.latency = malloc(len * sizeof(unsigned int));
+    randomWord(word, len);
+    coderInit(&coder);
+    unsigned int written = coderPush(&coder, word, len, code);
+    written += coderFlush(&coder, code + written);
+    if(written != codeLen)
+    {
+        printf("decoderSetEarly: stream encoding length mismatch\n");
+        return false;
+    }
+
+    for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+    {
+        memcpy(noisy, code, codeLen * sizeof(unsigned int));
+        channel(noisy, codeLen, errors[e]);
+        getDecode(noisy, codeLen, reference, len);
+        for(mode = 0; mode < 2; mode = mode + 1)            //0 - выдача по заполнению буфера, 1 - ранние решения
+        {
+            decoderInit(&decoder, DECODER_DEPTH);
+            if(mode)
+            {
+                decoderSetEarly(&decoder, earlySink, &sink);
+            }
+            sink.count = 0;
+            sink.step = 0;
+            double start = now();
+            for(sink.step = 1; sink.step <= codeLen / N; sink.step = sink.step + 1)
+            {
+                unsigned int got = decoderPush(&decoder, noisy + N*(sink.step - 1), N, mode ? NULL : output);
+                if(!mode)
+                {
+                    earlySink(&sink, output, got);
+                }
+            }
+            unsigned int got = decoderFlush(&decoder, mode ? NULL : output);
+            if(!mode)
+            {
+                earlySink(&sink, output, got);
+            }
+            double time = now() - start;
+            if(sink.count != len)
+            {
+                printf("decoderSetEarly: %u symbols decoded instead of %u\n", sink.count, len);
+                return false;
+            }
+            unsigned int bitErrors = 0, differences = 0;
+            for(i = 0; i < len; i = i + 1)
+            {
+                bitErrors += sink.bits[i] != word[i];
+                differences += sink.bits[i] != reference[len - 1 - i];  //getDecode выдает слово в обратном порядке
+            }
+            if((errors[e] == 0) && bitErrors)
+            {
+                printf("decoderSetEarly: clean stream decoded with %u errors\n", bitErrors);
+                return false;
+            }
+            qsort(sink.latency, len, sizeof(unsigned int), compareLatency);
+            printf("stream decoder %-5s p=%.2f  latency p50 %3u p99 %3u max %3u steps  %6.2f Mbit/s  "
+                   "BER %.5f  differs from getDecode %u\n",
+                   mode ? "early" : "fixed", errors[e], sink.latency[len / 2], sink.latency[len - len / 100],
+                   sink.latency[len - 1], len / time * 1e-6, (double)bitErrors / len, differences);
+        }
+    }
+    free(word);
+    free(code);
+    free(noisy);
+    free(reference);
+    free(output);
+    free(sink.bits);
+    free(sink.latency);
+    return true;
+}
+
+/**
+ * @brief проверка и замер быстрого пути getDecode: кадры декодируются
+ *        getDecode и полным алгоритмом Витерби (getDecodeQuantized с
+ *        одноразрядными символами - те же метрики без быстрого пути).
+ *        Результаты должны совпадать; выводится доля кадров быстрого пути
+ * @param
+ */
+static bool benchFastPath(void)
+{
+    unsigned int len = 1024;                                //длина кадра
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int frames = 2000;                             //количество кадров на точку
+    double errors[] = {0.0, 1e-5, 1e-4, 1e-3, 1e-2};        //вероятности ошибки в канале
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *decoded = malloc(len * sizeof(unsigned int));
+    unsigned int *reference = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc((size_t)frames * codeLen * sizeof(unsigned int));
+    uint8_t *symbols = malloc(codeLen);
+    unsigned int e, f, i;
+
+    randomWord(word, len);
+    for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+    {
+        for(f = 0; f < frames; f = f + 1)
+        {
+            getCodeWord(word, len, code + (size_t)f * codeLen, codeLen);
+            channel(code + (size_t)f * codeLen, codeLen, errors[e]);
+        }
+        uint64_t framesBefore, hitsBefore, framesAfter, hitsAfter;
+        double fastTime = 0, fullTime = 0;
+        getDecodeFastStats(&framesBefore, &hitsBefore);
+        for(f = 0; f < frames; f = f + 1)
+        {
+            unsigned int *noisy = code + (size_t)f * codeLen;
+            double start = now();
+            getDecode(noisy, codeLen, decoded, len);
+            fastTime += now() - start;
+
+            for(i = 0; i < codeLen; i = i + 1)
+            {
+                symbols[i] = noisy[i];
+            }
+            start = now();
+            getDecodeQuantized(symbols, codeLen, 1, reference, len);
+            fullTime += now() - start;
+            if(memcmp(decoded, reference, len * sizeof(unsigned int)) != 0)
+            {
+                printf("getDecode: fast path result differs from full decoding at p=%g\n", errors[e]);
+                return false;
+            }
+        }
+        getDecodeFastStats(&framesAfter, &hitsAfter);
+        if((errors[e] == 0) && (hitsAfter - hitsBefore != frames))
+        {
+            printf("getDecode: clean frames missed the fast path\n");
+            return false;
+        }
+        printf("decoder fast path len=%u p=%-6g  hits %5.1f%%  %7.2f Mbit/s (full Viterbi %6.2f Mbit/s, x%.1f)\n",
+               len, errors[e], 100.0 * (hitsAfter - hitsBefore) / (framesAfter - framesBefore),
+               (double)frames * len / fastTime * 1e-6, (double)frames * len / fullTime * 1e-6,
+               fullTime / fastTime);
+    }
+    free(word);
+    free(decoded);
+    free(reference);
+    free(code);
+    free(symbols);
+    return true;
+}
+
+/**
+ * @brief проверка и замер декодера с пропуском шагов ACS на участках без
+ *        ошибок: результат сравнивается с getDecode на кадрах случайной длины
+ *        с ошибками и стираниями, затем замеряется скорость на длинных словах
+ *        при разной вероятности ошибки
+ * @param
+ */
+static bool benchSyndrome(void)
+{
+    unsigned int lens[] = {10000, 1000000};                 //длины слов для замера скорости
+    double errors[] = {0.0, 1e-5, 1e-4, 1e-3, 1e-2, 0.03};  //вероятности ошибки в канале
+    unsigned int maxLen = 1000000;
+    unsigned int *word = malloc(maxLen * sizeof(unsigned int));
+    unsigned int *decoded = malloc(maxLen * sizeof(unsigned int));
+    unsigned int *reference = malloc(maxLen * sizeof(unsigned int));
+    unsigned int *code = malloc(N*(maxLen + SIZE-1) * sizeof(unsigned int));
+    unsigned int l, e, f;
+
+    for(f = 0; f < 3000; f = f + 1)                         //кадры случайной длины, ошибки и стирания
+    {
+        unsigned int len = 1 + rand() % 400;
+        unsigned int codeLen = N*(len + SIZE-1);
+        randomWord(word, len);
+        getCodeWord(word, len, code, codeLen);
+        channel(code, codeLen, (f % 4) * 0.01);
+        if(f % 5 == 0)
+        {
+            code[rand() % codeLen] = ERASURE;
+        }
+        getDecode(code, codeLen, reference, len);
+        getDecodeSyndrome(code, codeLen, decoded, len);
+        if(memcmp(decoded, reference, len * sizeof(unsigned int)) != 0)
+        {
+            printf("getDecodeSyndrome: result differs from getDecode (frame %u, len %u)\n", f, len);
+            return false;
+        }
+    }
+
+    for(l = 0; l < sizeof(lens) / sizeof(lens[0]); l = l + 1)
+    {
+        unsigned int len = lens[l];
+        unsigned int codeLen = N*(len + SIZE-1);
+        randomWord(word, len);
+        for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+        {
+            unsigned int repeat = 10000000 / len;            //повторы для коротких слов
+            unsigned int r;
+            getCodeWord(word, len, code, codeLen);
+            channel(code, codeLen, errors[e]);
+            double start = now();
+            for(r = 0; r < repeat; r = r + 1)
+            {
+                getDecode(code, codeLen, reference, len);
+            }
+            double fullTime = (now() - start) / repeat;
+            start = now();
+            for(r = 0; r < repeat; r = r + 1)
+            {
+                getDecodeSyndrome(code, codeLen, decoded, len);
+            }
+            double syndromeTime = (now() - start) / repeat;
+            if(memcmp(decoded, reference, len * sizeof(unsigned int)) != 0)
+            {
+                printf("getDecodeSyndrome: result differs from getDecode (len %u, p=%g)\n", len, errors[e]);
+                return false;
+            }
+            printf("syndrome decoder len=%-7u p=%-6g  %8.2f Mbit/s (getDecode %6.2f Mbit/s, x%.1f)\n",
+                   len, errors[e], len / syndromeTime * 1e-6, len / fullTime * 1e-6, fullTime / syndromeTime);
+        }
+    }
+    free(word);
+    free(decoded);
+    free(reference);
+    free(code);
+    return true;
+}
+
+/**
+ * @brief проверка и замер декодирования в рабочей области вызывающей стороны
+ *        (getDecodeWorkspace): результаты сравниваются с getDecode,
+ *        getDecodeSoft и getDecodeQuantized, проверяется отказ при невыровненной
+ *        и малой области. Короткие кадры замеряются с одной областью на все
+ *        кадры против выделения памяти при каждом вызове getDecode, длинное
+ *        слово - с областью в больших страницах
+ * @param
+ */
+static bool benchWorkspace(void)
+{
+    unsigned int maxLen = 1000000;                          //длина длинного слова
+    unsigned int *word = malloc(maxLen * sizeof(unsigned int));
+    unsigned int *decoded = malloc(maxLen * sizeof(unsigned int));
+    unsigned int *reference = malloc(maxLen * sizeof(unsigned int));
+    unsigned int *code = malloc(N*(maxLen + SIZE-1) * sizeof(unsigned int));
+    int8_t *llr = malloc(N*(maxLen + SIZE-1));
+    uint8_t *q3 = malloc(N*(maxLen + SIZE-1));
+    size_t size = getDecodeWorkspaceSize(N*(400 + SIZE-1), DECODE_LLR);  //область для кадров до 400 бит
+    void *workspace = NULL;
+    unsigned int f, i;
+
+    if(posix_memalign(&workspace, DECODE_WORKSPACE_ALIGN, size) != 0)
+    {
+        printf("getDecodeWorkspace: can't allocate workspace\n");
+        return false;
+    }
+    if((getDecodeWorkspaceSize(16, DECODE_QUANTIZED(0)) != 0)
+       || getDecodeWorkspace(code, N*(400 + SIZE-1), DECODE_HARD, decoded, 400, (uint8_t *)workspace + 8, size - 8)
+       || getDecodeWorkspace(code, N*(400 + SIZE-1) + 64*N, DECODE_HARD, decoded, 400, workspace, size))
+    {
+        printf("getDecodeWorkspace: invalid options or workspace accepted\n");
+        return false;
+    }
+    for(f = 0; f < 3000; f = f + 1)                         //кадры случайной длины, ошибки и стирания
+    {
+        unsigned int len = 1 + rand() % 400;
+        unsigned int codeLen = N*(len + SIZE-1);
+        randomWord(word, len);
+        getCodeWord(word, len, code, codeLen);
+        channel(code, codeLen, (f % 4) * 0.01);
+        if(f % 5 == 0)
+        {
+            code[rand() % codeLen] = ERASURE;
+        }
+        for(i = 0; i < codeLen; i = i + 1)
+        {
+            double y = ((code[i] == ERASURE) ? 0.0 : (code[i] ? -1.0 : 1.0)) + 0.5 * gaussian();
+            llr[i] = (y <= -1.0) ? -127 : (y >= 1.0) ? 127 : (int8_t)lrint(y * 127);
+            q3[i] = (y <= -1.0) ? 0 : (y >= 1.0) ? 7 : (uint8_t)lrint((y + 1.0) * 3.5);
+        }
+        getDecode(code, codeLen, reference, len);
+        if(!getDecodeWorkspace(code, codeLen, DECODE_HARD, decoded, len, workspace, size)
+           || (memcmp(decoded, reference, len * sizeof(unsigned int)) != 0))
+        {
+            printf("getDecodeWorkspace: hard result differs from getDecode (frame %u, len %u)\n", f, len);
+            return false;
+        }
+        getDecodeSoft(llr, codeLen, reference, len);
+        if(!getDecodeWorkspace(llr, codeLen, DECODE_LLR, decoded, len, workspace, size)
+           || (memcmp(decoded, reference, len * sizeof(unsigned int)) != 0))
+        {
+            printf("getDecodeWorkspace: LLR result differs from getDecodeSoft (frame %u, len %u)\n", f, len);
+            return false;
+        }
+        getDecodeQuantized(q3, codeLen, 3, reference, len);
+        if(!getDecodeWorkspace(q3, codeLen, DECODE_QUANTIZED(3), decoded, len, workspace, size)
+           || (memcmp(decoded, reference, len * sizeof(unsigned int)) != 0))
+        {
+            printf("getDecodeWorkspace: 3-bit result differs from getDecodeQuantized (frame %u, len %u)\n", f, len);
+            return false;
+        }
+    }
+
+    unsigned int len = 256;                                 //короткие кадры: затраты на выделение памяти заметны
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int frames = 200000;
+    randomWord(word, len);
+    getCodeWord(word, len, code, codeLen);
+    channel(code, codeLen, 0.01);                           //с ошибками, чтобы не сработал быстрый путь
+    double start = now();
+    for(f = 0; f < frames; f = f + 1)
+    {
+        getDecode(code, codeLen, reference, len);
+    }
+    double heapTime = now() - start;
+    start = now();
+    for(f = 0; f < frames; f = f + 1)
+    {
+        getDecodeWorkspace(code, codeLen, DECODE_HARD, decoded, len, workspace, size);
+    }
+    double workspaceTime = now() - start;
+    if(memcmp(decoded, reference, len * sizeof(unsigned int)) != 0)
+    {
+        printf("getDecodeWorkspace: result differs from getDecode (len %u)\n", len);
+        return false;
+    }
+    printf("workspace decoder len=%-7u  %8.1f ns/frame (getDecode %8.1f ns/frame, x%.2f)\n",
+           len, workspaceTime / frames * 1e9, heapTime / frames * 1e9, heapTime / workspaceTime);
+    free(workspace);
+
+    len = maxLen;                                           //длинное слово: область в больших страницах
+    codeLen = N*(len + SIZE-1);
+    size = getDecodeWorkspaceSize(codeLen, DECODE_HARD);
+    size_t huge = 2u << 20;                                 //размер большой страницы
+    size_t mapped = (size + huge - 1) / huge * huge;
+    workspace = mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(workspace == MAP_FAILED)
+    {
+        printf("getDecodeWorkspace: can't map workspace\n");
+        return false;
+    }
+    madvise(workspace, mapped, MADV_HUGEPAGE);              //без поддержки ядром - обычные страницы
+    randomWord(word, len);
+    getCodeWord(word, len, code, codeLen);
+    channel(code, codeLen, 0.01);
+    start = now();
+    getDecode(code, codeLen, reference, len);
+    heapTime = now() - start;
+    start = now();
+    getDecodeWorkspace(code, codeLen, DECODE_HARD, decoded, len, workspace, mapped);
+    workspaceTime = now() - start;
+    start = now();
+    getDecodeWorkspace(code, codeLen, DECODE_HARD, decoded, len, workspace, mapped);
+    double warmTime = now() - start;
+    if(memcmp(decoded, reference, len * sizeof(unsigned int)) != 0)
+    {
+        printf("getDecodeWorkspace: result differs from getDecode (len %u)\n", len);
+        return false;
+    }
+    printf("workspace decoder len=%-7u  %8.2f Mbit/s first, %8.2f Mbit/s reused (getDecode %6.2f Mbit/s), "
+           "workspace %.1f MB\n", len, len / workspaceTime * 1e-6, len / warmTime * 1e-6, len / heapTime * 1e-6,
+           size / 1e6);
+    munmap(workspace, mapped);
+    free(word);
+    free(decoded);
+    free(reference);
+    free(code);
+    free(llr);
+    free(q3);
+    return true;
+}
+
+/**
+ * @brief проверка и замер упакованного тракта (getCodeWordPackedOrder +
+ *        getDecodePacked) относительно тракта с символом на unsigned int:
+ *        распаковка байтов, getCodeWord, упаковка кода; распаковка кода,
+ *        getDecode, упаковка результата. Скорость - входные байты в секунду
+ * @param
+ */
+static bool benchPackedPipeline(void)
+{
+    unsigned int lens[] = {1, 7, 8, 9, 40, 1023, 4096};     //длины проверочных слов
+    unsigned int maxLen = 1 << 20;                          //длина слова для замера
+    unsigned int maxCode = N*(maxLen + SIZE-1);
+    uint8_t *packedWord = malloc(maxLen / 8);
+    uint8_t *msbWord = malloc(maxLen / 8);
+    uint8_t *packedCode = malloc((maxCode + 7) / 8);
+    uint8_t *msbCode = malloc((maxCode + 7) / 8);
+    uint8_t *packedDecoded = malloc(maxLen / 8);
+    uint8_t *referencePacked = malloc(maxLen / 8);
+    unsigned int *word = malloc(maxLen * sizeof(unsigned int));
+    unsigned int *code = malloc(maxCode * sizeof(unsigned int));
+    unsigned int *decoded = malloc(maxLen * sizeof(unsigned int));
+    unsigned int l, o, i;
+
+    for(o = 0; o < 2; o = o + 1)
+    {
+        eBitOrder order = o ? BIT_ORDER_LSB : BIT_ORDER_MSB;
+        for(l = 0; l < sizeof(lens) / sizeof(lens[0]); l = l + 1)
+        {
+            unsigned int len = lens[l];
+            unsigned int codeLen = N*(len + SIZE-1);
+            unsigned int bytes = (len + 7) / 8;
+            for(i = 0; i < bytes; i = i + 1)
+            {
+                packedWord[i] = rand();
+            }
+            if(len % 8)                                     //лишние биты последнего байта обнуляются
+            {
+                packedWord[bytes - 1] &= o ? (0xFF >> (8 - len % 8)) : (0xFF << (8 - len % 8));
+            }
+            for(i = 0; i < bytes; i = i + 1)
+            {
+                msbWord[i] = o ? bitReverseTable[packedWord[i]] : packedWord[i];
+            }
+            getCodeWordPacked(msbWord, len, msbCode);
+            getCodeWordPackedOrder(packedWord, len, packedCode, order);
+            for(i = 0; i < (codeLen + 7) / 8; i = i + 1)
+            {
+                if(packedCode[i] != (o ? bitReverseTable[msbCode[i]] : msbCode[i]))
+                {
+                    printf("getCodeWordPackedOrder: mismatch for wordLen = %u\n", len);
+                    return false;
+                }
+            }
+
+            unpackBits(msbCode, codeLen, false, code);       //тот же код с ошибками в обоих трактах
+            channel(code, codeLen, 0.02);
+            packBits(code, codeLen, false, msbCode);
+            for(i = 0; i < (codeLen + 7) / 8; i = i + 1)
+            {
+                packedCode[i] = o ? bitReverseTable[msbCode[i]] : msbCode[i];
+            }
+            getDecode(code, codeLen, decoded, len);
+            packBits(decoded, len, true, referencePacked);  //getDecode выдает слово в обратном порядке
+            getDecodePacked(packedCode, codeLen, packedDecoded, len, order);
+            for(i = 0; i < bytes; i = i + 1)
+            {
+                if(packedDecoded[i] != (o ? bitReverseTable[referencePacked[i]] : referencePacked[i]))
+                {
+                    printf("getDecodePacked: result differs from getDecode for wordLen = %u\n", len);
+                    return false;
+                }
+            }
+        }
+    }
+
+    unsigned int len = maxLen;
+    unsigned int codeLen = maxCode;
+    for(i = 0; i < len / 8; i = i + 1)
+    {
+        packedWord[i] = rand();
+    }
+    double start = now();                                   //тракт с символом на unsigned int
+    unpackBits(packedWord, len, true, word);
+    getCodeWord(word, len, code, codeLen);
+    packBits(code, codeLen, false, msbCode);
+    double wordEncode = now() - start;
+    unpackBits(msbCode, codeLen, false, code);
+    channel(code, codeLen, 0.01);
+    packBits(code, codeLen, false, msbCode);
+    start = now();
+    unpackBits(msbCode, codeLen, false, code);
+    getDecode(code, codeLen, decoded, len);
+    packBits(decoded, len, true, referencePacked);
+    double wordDecode = now() - start;
+
+    for(o = 0; o < 2; o = o + 1)                            //упакованный тракт
+    {
+        eBitOrder order = o ? BIT_ORDER_LSB : BIT_ORDER_MSB;
+        start = now();
+        getCodeWordPackedOrder(packedWord, len, packedCode, order);
+        double packedEncode = now() - start;
+        for(i = 0; i < (codeLen + 7) / 8; i = i + 1)        //те же ошибки канала
+        {
+            packedCode[i] = o ? bitReverseTable[msbCode[i]] : msbCode[i];
+        }
+        start = now();
+        getDecodePacked(packedCode, codeLen, packedDecoded, len, order);
+        double packedDecode = now() - start;
+        for(i = 0; i < len / 8; i = i + 1)
+        {
+            if(packedDecoded[i] != (o ? bitReverseTable[referencePacked[i]] : referencePacked[i]))
+            {
+                printf("getDecodePacked: result differs from getDecode on the long word\n");
+                return false;
+            }
+        }
+        printf("packed %s  encode %8.2f MB/s (unsigned int %7.2f) | decode %6.2f MB/s (unsigned int %6.2f) | "
+               "end to end %6.2f MB/s (unsigned int %6.2f, x%.2f)  buffers %u vs %u bytes\n",
+               o ? "LSB" : "MSB", len / 8 / packedEncode * 1e-6, len / 8 / wordEncode * 1e-6,
+               len / 8 / packedDecode * 1e-6, len / 8 / wordDecode * 1e-6,
+               len / 8 / (packedEncode + packedDecode) * 1e-6, len / 8 / (wordEncode + wordDecode) * 1e-6,
+               (wordEncode + wordDecode) / (packedEncode + packedDecode),
+               len / 8 + (codeLen + 7) / 8 + len / 8,
+               (unsigned int)((len + codeLen + len) * sizeof(unsigned int)));
+    }
+    free(packedWord); free(msbWord); free(packedCode); free(msbCode); free(packedDecoded);
+    free(referencePacked); free(word); free(code); free(decoded);
+    return true;
+}
+
+/**
+ * @brief резидентная память процесса в байтах (Linux, /proc/self/statm)
+ * @param
+ */
+static double residentBytes(void)
+{
+    unsigned long size = 0, resident = 0;
+    FILE *file = fopen("/proc/self/statm", "r");
+    if(file)
+    {
+        if(fscanf(file, "%lu %lu", &size, &resident) != 2)
+        {
+            resident = 0;
+        }
+        fclose(file);
+    }
+    return (double)resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief параллельное декодирование длинного слова участками с перекрытиями:
+ *        доля ошибок в сравнении с getDecode в зависимости от длины перекрытия
+ *        и ускорение в зависимости от количества потоков
+ * @param
+ */
+static bool benchParallelDecoder(void)
+{
+    unsigned int cores = sysconf(_SC_NPROCESSORS_ONLN);     //количество доступных ядер
+    unsigned int len = 2000000;
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int overlaps[] = {0, SIZE + 1, 2*(SIZE + 1), DECODER_DEPTH, 2*DECODER_DEPTH};
+    double errors[] = {0.0, 0.03};
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *serial = malloc(len * sizeof(unsigned int));
+    unsigned int *parallel = malloc(len * sizeof(unsigned int));
+    unsigned int e, o, t, i;
+
+    randomWord(word, len);
+    for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+    {
+        getCodeWord(word, len, code, codeLen);
+        channel(code, codeLen, errors[e]);
+        double start = now();
+        getDecode(code, codeLen, serial, len);
+        double serialTime = now() - start;
+        unsigned int serialErrors = 0;
+        for(i = 0; i < len; i = i + 1)
+        {
+            serialErrors += serial[i] != word[i];
+        }
+        printf("parallel p=%.2f  getDecode         %7.2f Mbit/s  BER %.6f\n",
+               errors[e], len / serialTime * 1e-6, (double)serialErrors / len);
+        for(o = 0; o < sizeof(overlaps) / sizeof(overlaps[0]); o = o + 1)
+        {
+            unsigned int bitErrors = 0, differ = 0;
+            getDecodeParallel(code, codeLen, parallel, len, 4, 9973, overlaps[o]); //участки не кратны длине слова
+            for(i = 0; i < len; i = i + 1)
+            {
+                bitErrors += parallel[i] != word[i];
+                differ += parallel[i] != serial[i];
+            }
+            if((errors[e] == 0) && bitErrors && (overlaps[o] >= SIZE + 1))
+            {
+                printf("getDecodeParallel: clean word decoded with %u errors (overlap %u)\n", bitErrors, overlaps[o]);
+                return false;
+            }
+            printf("parallel p=%.2f  overlap=%-3u        BER %.6f  (%u symbols differ from getDecode)\n",
+                   errors[e], overlaps[o], (double)bitErrors / len, differ);
+        }
+    }
+
+    double single = 0;
+    for(t = 1; t <= ((cores > 4) ? cores : 4); t = t + 1)
+    {
+        double start = now();
+        getDecodeParallel(code, codeLen, parallel, len, t, 0, DECODER_DEPTH);
+        double elapsed = now() - start;
+        if(t == 1)
+        {
+            single = elapsed;
+        }
+        printf("parallel threads=%-3u (cores %u)  %7.2f Mbit/s  (x%.2f)\n",
+               t, cores, len / elapsed * 1e-6, single / elapsed);
+    }
+    free(word); free(code); free(serial); free(parallel);
+    return true;
+}
+
+/**
+ * @brief пакетное декодирование коротких кадров (getDecodeBatch) в сравнении
+ *        с декодированием по одному кадру (getDecode): кадров в секунду для
+ *        пакетов от 1 до 256 кадров
+ * @param
+ */
+static bool benchBatch(void)
+{
+    unsigned int len = 40;
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int frames = 4096;                             //количество кадров на замер
+    unsigned int batches[] = {1, 2, 4, 8, 16, 24, 32, 64, 128, 256};
+    unsigned int *words = malloc(frames * len * sizeof(unsigned int));
+    unsigned int *codes = malloc(frames * codeLen * sizeof(unsigned int));
+    unsigned int *reference = malloc(frames * len * sizeof(unsigned int));
+    unsigned int *decoded = malloc(frames * len * sizeof(unsigned int));
+    unsigned int **codePtr = malloc(frames * sizeof(unsigned int*));
+    unsigned int **decodedPtr = malloc(frames * sizeof(unsigned int*));
+    eAcsKernel kernel = acsKernel();
+    unsigned int f, b, k;
+
+    for(f = 0; f < frames; f = f + 1)
+    {
+        randomWord(words + f*len, len);
+        getCodeWord(words + f*len, len, codes + f*codeLen, codeLen);
+        channel(codes + f*codeLen, codeLen, 0.02);
+        codePtr[f] = codes + f*codeLen;
+        decodedPtr[f] = decoded + f*len;
+    }
+    double start = now();
+    for(f = 0; f < frames; f = f + 1)
+    {
+        getDecode(codePtr[f], codeLen, reference + f*len, len);
+    }
+    double single = now() - start;
+    printf("batch    len=%u  getDecode one by one      %9.0f frames/s\n", len, frames / single);
+
+    for(k = 0; k < ACS_KERNELS; k = k + 1)                  //все пакетные реализации совпадают с getDecode
+    {
+        if(acsSelect(k))
+        {
+            memset(decoded, 0xFF, frames * len * sizeof(unsigned int));
+            getDecodeBatch(codePtr, frames - 3, codeLen, decodedPtr, len);  //последняя группа неполная
+            if(memcmp(decoded, reference, (frames - 3) * len * sizeof(unsigned int)))
+            {
+                printf("getDecodeBatch (%s): mismatch with getDecode\n", acsKernelName(k));
+                acsSelect(kernel);
+                return false;
+            }
+        }
+    }
+    acsSelect(kernel);
+
+    for(b = 0; b < sizeof(batches) / sizeof(batches[0]); b = b + 1)
+    {
+        start = now();
+        for(f = 0; f < frames; f = f + batches[b])
+        {
+            unsigned int count = (frames - f < batches[b]) ? (frames - f) : batches[b];    //последний пакет может быть неполным
+            getDecodeBatch(codePtr + f, count, codeLen, decodedPtr + f, len);
+        }
+        double time = now() - start;
+        printf("batch    len=%u  getDecodeBatch batch=%-3u %9.0f frames/s  (x%.2f)\n",
+               len, batches[b], frames / time, single / time);
+    }
+    free(words); free(codes); free(reference); free(decoded); free(codePtr); free(decodedPtr);
+    return true;
+}
+
+/**
+ * @brief длительный прогон исходного декодера (getDecodeTreeWith): резидентная
+ *        память не должна расти, так как узлы дерева путей берутся из пула,
+ *        сбрасываемого после каждого окна. Отдельно сравнивается скорость
+ *        выделения узлов из пула и через malloc/free
+ * @param
+ */
+static bool benchTreeSoak(void)
+{
+    unsigned int len = 40;
+    unsigned int codeLen = N*(len + SIZE-1);
+    unsigned int frames = 20000;                            //количество кадров прогона
+    unsigned int word[64], decoded[64], code[N*(64 + SIZE)];
+    unsigned int f, k;
+    double warm = 0;                                        //память после первой четверти прогона
+    sTreeDecoder decoder;                                   //контекст декодера, пул сохраняется между кадрами
+
+    treeDecoderInit(&decoder);
+    double start = now();
+    for(f = 0; f < frames; f = f + 1)
+    {
+        randomWord(word, len);
+        getCodeWord(word, len, code, codeLen);
+        channel(code, codeLen, 0.02);
+        getDecodeTreeWith(&decoder, code, codeLen, decoded, len);
+        if((f + 1) % (frames / 4) == 0)
+        {
+            double rss = residentBytes();
+            if(warm == 0)
+            {
+                warm = rss;
+            }
+            printf("tree soak %6u frames  RSS %8.0f KB  pool %u nodes (%u bytes/node)\n",
+                   f + 1, rss / 1024, decoder.pool.capacity, (unsigned int)sizeof(sTree));
+        }
+    }
+    double time = now() - start;
+    treeDecoderFree(&decoder);
+    double growth = residentBytes() - warm;
+    printf("tree soak %.1f us/frame, RSS growth after warm-up %.0f KB\n", time / frames * 1e6, growth / 1024);
+    if(growth > 1024*1024)
+    {
+        printf("getDecodeTree: resident memory grows during the soak\n");
+        return false;
+    }
+
+    unsigned int windows = 200000;                          //количество окон
+    unsigned int nodes = 64;                                //узлов на окно
+    sTreePool pool = {NULL, 0, 0};
+    sTree **blocks = malloc(nodes * sizeof(sTree*));
+    start = now();
+    for(f = 0; f < windows; f = f + 1)
+    {
+        for(k = 0; k < nodes; k = k + 1)
+        {
+            blocks[k] = malloc(sizeof(sTree));
+            blocks[k]->data = k;
+        }
+        for(k = 0; k < nodes; k = k + 1)
+        {
+            free(blocks[k]);
+        }
+    }
+    double mallocTime = now() - start;
+    unsigned int check = 0;
+    start = now();
+    for(f = 0; f < windows; f = f + 1)
+    {
+        for(k = 0; k < nodes; k = k + 1)
+        {
+            uint32_t node = treeAlloc(&pool);
+            pool.nodes[node].data = k;
+            check += node;
+        }
+        treeReset(&pool);
+    }
+    double poolTime = now() - start;
+    treeFree(&pool);
+    free(blocks);
+    if(check != windows * (nodes*(nodes + 1)/2))            //номера узлов окна - 1..nodes
+    {
+        printf("treeAlloc: unexpected node numbers\n");
+        return false;
+    }
+    printf("tree nodes: malloc/free %6.1f Mnodes/s | pool %7.1f Mnodes/s (%.1fx)\n",
+           windows * nodes / mallocTime * 1e-6, windows * nodes / poolTime * 1e-6, mallocTime / poolTime);
+    return true;
+}
+
+/**
+ * @brief задание потока замера масштабирования: поток декодирует общий набор
+ *        кадров своими контекстами и сравнивает результат с эталоном
+ */
+typedef struct
+{
+    unsigned int *codes;                                    //кадры для getDecode
+    unsigned int *reference;                                //эталон getDecode
+    unsigned int *treeCodes;                                //кадры для getDecodeTreeWith
+    unsigned int *treeReference;                            //эталон getDecodeTreeWith
+    unsigned int rounds;                                    //количество проходов по набору
+    bool ok;                                                //результат совпал с эталоном
+}sThreadJob;
+
+#define THREAD_FRAMES 32                                    //кадров getDecode в наборе
+#define THREAD_LEN 4096                                     //длина кадра getDecode
+#define THREAD_TREE_FRAMES 64                               //кадров getDecodeTreeWith в наборе
+#define THREAD_TREE_LEN 40                                  //длина кадра getDecodeTreeWith
+
+/**
+ * @brief поток замера масштабирования
+ * @param
+ *  arg - указатель на задание sThreadJob
+ */
+static void *threadJob(void *arg)
+{
+    sThreadJob *job = arg;
+    unsigned int codeLen = N*(THREAD_LEN + SIZE-1);
+    unsigned int treeCodeLen = N*(THREAD_TREE_LEN + SIZE-1);
+    unsigned int *decoded = malloc(THREAD_LEN * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    sTreeDecoder tree;                                      //собственный контекст декодера потока
+    unsigned int r, f;
+
+    treeDecoderInit(&tree);
+    job->ok = true;
+    for(r = 0; r < job->rounds; r = r + 1)
+    {
+        for(f = 0; f < THREAD_FRAMES; f = f + 1)
+        {
+            getDecode(job->codes + f * codeLen, codeLen, decoded, THREAD_LEN);
+            job->ok &= !memcmp(decoded, job->reference + f * THREAD_LEN, THREAD_LEN * sizeof(unsigned int));
+        }
+        for(f = 0; f < THREAD_TREE_FRAMES; f = f + 1)
+        {
+            memcpy(code, job->treeCodes + f * treeCodeLen, treeCodeLen * sizeof(unsigned int));
+            getDecodeTreeWith(&tree, code, treeCodeLen, decoded, THREAD_TREE_LEN);
+            job->ok &= !memcmp(decoded, job->treeReference + f * THREAD_TREE_LEN,
+                               THREAD_TREE_LEN * sizeof(unsigned int));
+        }
+    }
+    treeDecoderFree(&tree);
+    free(decoded);
+    free(code);
+    return NULL;
+}
+
+/**
+ * @brief масштабирование по потокам: каждый поток декодирует один и тот же
+ *        набор кадров getDecode и getDecodeTreeWith в своих контекстах.
+ *        Результаты всех потоков должны совпасть с однопоточным эталоном;
+ *        выводится суммарная скорость и доля линейного роста
+ * @param
+ */
+static bool benchThreads(void)
+{
+    unsigned int codeLen = N*(THREAD_LEN + SIZE-1);
+    unsigned int treeCodeLen = N*(THREAD_TREE_LEN + SIZE-1);
+    unsigned int cores = sysconf(_SC_NPROCESSORS_ONLN);     //количество процессоров
+    unsigned int rounds = 4;                                //проходов по набору в каждом потоке
+    unsigned int *word = malloc(THREAD_LEN * sizeof(unsigned int));
+    unsigned int *codes = malloc(THREAD_FRAMES * codeLen * sizeof(unsigned int));
+    unsigned int *reference = malloc(THREAD_FRAMES * THREAD_LEN * sizeof(unsigned int));
+    unsigned int *treeCodes = malloc(THREAD_TREE_FRAMES * treeCodeLen * sizeof(unsigned int));
+    unsigned int *treeReference = malloc(THREAD_TREE_FRAMES * THREAD_TREE_LEN * sizeof(unsigned int));
+    unsigned int *code = malloc(treeCodeLen * sizeof(unsigned int));
+    double single = 0;                                      //скорость одного потока
+    unsigned int threads, f, t;
+
+    if(cores < 1)
+    {
+        cores = 1;
+    }
+    for(f = 0; f < THREAD_FRAMES; f = f + 1)
+    {
+        randomWord(word, THREAD_LEN);
+        getCodeWord(word, THREAD_LEN, codes + f * codeLen, codeLen);
+        channel(codes + f * codeLen, codeLen, 0.02);
+        getDecode(codes + f * codeLen, codeLen, reference + f * THREAD_LEN, THREAD_LEN);
+    }
+    for(f = 0; f < THREAD_TREE_FRAMES; f = f + 1)
+    {
+        randomWord(word, THREAD_TREE_LEN);
+        getCodeWord(word, THREAD_TREE_LEN, treeCodes + f * treeCodeLen, treeCodeLen);
+        channel(treeCodes + f * treeCodeLen, treeCodeLen, 0.02);
+        memcpy(code, treeCodes + f * treeCodeLen, treeCodeLen * sizeof(unsigned int));
+        getDecodeTree(code, treeCodeLen, treeReference + f * THREAD_TREE_LEN, THREAD_TREE_LEN);
+    }
+
+    for(threads = 1; threads <= cores; threads = (threads == cores) ? (cores + 1) :
+        ((2*threads < cores) ? (2*threads) : cores))
+    {
+        pthread_t *ids = malloc(threads * sizeof(pthread_t));
+        sThreadJob *jobs = malloc(threads * sizeof(sThreadJob));
+        double start = now();
+        for(t = 0; t < threads; t = t + 1)
+        {
+            jobs[t] = (sThreadJob){codes, reference, treeCodes, treeReference, rounds, false};
+            pthread_create(&ids[t], NULL, threadJob, &jobs[t]);
+        }
+        bool ok = true;
+        for(t = 0; t < threads; t = t + 1)
+        {
+            pthread_join(ids[t], NULL);
+            ok &= jobs[t].ok;
+        }
+        double time = now() - start;
+        free(ids);
+        free(jobs);
+        if(!ok)
+        {
+            printf("threads: %u concurrent decoders disagree with the single-threaded result\n", threads);
+            return false;
+        }
+        double rate = (double)threads * rounds * (THREAD_FRAMES * THREAD_LEN + THREAD_TREE_FRAMES * THREAD_TREE_LEN)
+                    / time * 1e-6;
+        if(threads == 1)
+        {
+            single = rate;
+        }
+        printf("threads %3u/%u  getDecode + getDecodeTreeWith %8.2f Mbit/s  scaling %5.1f%% of linear\n",
+               threads, cores, rate, 100.0 * rate / (threads * single));
+    }
+    free(word);
+    free(codes);
+    free(reference);
+    free(treeCodes);
+    free(treeReference);
+    free(code);
+    return true;
+}
+
+/**
+ * @brief память выживших путей на декодированный бит: исходный декодер хранит
+ *        дерево путей (не менее узла sTree на шаг), массив путей sPath[S] на
+ *        окно из DEPTH шагов и узел пути в checked; декодер ACS - одно слово
+ *        решений на шаг, потоковый декодер - кольцевой буфер постоянного размера
+ * @param
+ */
+static bool benchSurvivor(void)
+{
+    unsigned int lens[] = {40, 1000, 100000, 10000000};
+    unsigned int l;
+    double tree = sizeof(sTree) + sizeof(unsigned int) + (double)(S * sizeof(sPath)) / DEPTH;
+    double acs = sizeof(uint64_t);
+
+    for(l = 0; l < sizeof(lens) / sizeof(lens[0]); l = l + 1)
+    {
+        double stream = (double)sizeof(sDecoder) / lens[l];
+        printf("survivor len=%-8u tree >= %8.1f B/bit | ACS %5.1f B/bit (%6.1fx less) | "
+               "stream %8.4f B/bit (%u bytes total)\n",
+               lens[l], tree, acs, tree / acs, stream, (unsigned int)sizeof(sDecoder));
+    }
+    return tree / acs > 100;
+}
+
+/**
+ * @brief сравнение циклического завершения (tail-biting) с нулевым хвостом:
+ *        стоимость декодирования, доля ошибочных кадров и сэкономленная полоса.
+ *        Чистые кадры должны декодироваться без ошибок, а доля ошибочных
+ *        кадров в канале с ошибками - не превышать долю декодера с нулевым
+ *        хвостом более чем вдвое (с запасом 0.5%)
+ * @param
+ */
+static bool benchTailBiting(void)
+{
+    unsigned int lens[] = {40, 56};                         //длины управляющих кадров
+    double errors[] = {0.0, 0.02};                          //вероятности ошибки в канале
+    unsigned int frames = 2000;                             //количество кадров на точку
+    unsigned int l, e, f;
+    for(l = 0; l < sizeof(lens) / sizeof(lens[0]); l = l + 1)
+    {
+        unsigned int len = lens[l];
+        unsigned int zeroLen = N*(len + SIZE-1);            //длина кодового слова с нулевым хвостом
+        unsigned int tbLen = N*len;                         //длина кодового слова с циклическим завершением
+        unsigned int word[64], decoded[64];
+        unsigned int code[N*(64 + SIZE)];
+        for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+        {
+            unsigned int zeroFail = 0, tbFail = 0;          //количество ошибочно декодированных кадров
+            double zeroTime = 0, tbTime = 0;
+            for(f = 0; f < frames; f = f + 1)
+            {
+                randomWord(word, len);
+
+                getCodeWord(word, len, code, zeroLen);
+                channel(code, zeroLen, errors[e]);
+                double start = now();
+                getDecode(code, zeroLen, decoded, len);
+                zeroTime += now() - start;
+                zeroFail += memcmp(word, decoded, len * sizeof(unsigned int)) != 0;
+
+                getCodeWordTailBiting(word, len, code, tbLen);
+                channel(code, tbLen, errors[e]);
+                start = now();
+                if(!getDecodeTailBiting(code, tbLen, decoded, len))
+                {
+                    printf("getDecodeTailBiting: out of memory\n");
+                    return false;
+                }
+                tbTime += now() - start;
+                tbFail += memcmp(word, decoded, len * sizeof(unsigned int)) != 0;
+            }
+            if((errors[e] == 0) && (tbFail > 0))
+            {
+                printf("getDecodeTailBiting: %u clean frames decoded wrongly\n", tbFail);
+                return false;
+            }
+            if(tbFail > 2*zeroFail + frames / 200)          //у декодера по максимуму правдоподобия FER близка к нулевому хвосту
+            {
+                printf("getDecodeTailBiting: FER %.3f at p=%.2f, zero-tail FER %.3f\n",
+                       (double)tbFail / frames, errors[e], (double)zeroFail / frames);
+                return false;
+            }
+            printf("tail-biting len=%-3u p=%.2f  zero-tail %3u bits %7.2f us/frame FER %.3f | "
+                   "tail-biting %3u bits (-%.1f%%) %7.2f us/frame FER %.3f\n",
+                   len, errors[e], zeroLen, zeroTime / frames * 1e6, (double)zeroFail / frames,
+                   tbLen, 100.0 * (zeroLen - tbLen) / zeroLen, tbTime / frames * 1e6, (double)tbFail / frames);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief проверка и замер пунктурирования для стандартных скоростей
+ * @param
+ */
+static bool benchPuncture(void)
+{
+    const char *names[] = {"1/2", "DVB 2/3", "DVB 3/4", "DVB 5/6", "DVB 7/8", "802.11 2/3", "802.11 3/4"};
+    unsigned int rates = sizeof(names) / sizeof(names[0]);
+    unsigned int len = 1 << 20;                             //длина слова для замера
+    unsigned int codeLen = N*len;
+    unsigned int *word = malloc(len * sizeof(unsigned int));
+    unsigned int *code = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *punctured = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *restored = malloc(codeLen * sizeof(unsigned int));
+    unsigned int *decoded = malloc(len * sizeof(unsigned int));
+    uint8_t *packedCode = malloc(codeLen / 8 + 1);
+    uint8_t *packedPunctured = malloc(codeLen / 8 + 1);
+    uint8_t *expected = malloc(codeLen / 8 + 1);
+    sPuncture *puncture = malloc(sizeof(sPuncture));
+    bool ok = true;
+    unsigned int r;
+
+    randomWord(word, len);
+    getCodeWordTailBiting(word, len, code, codeLen);
+    packBits(code, codeLen, false, packedCode);
+    for(r = 0; (r < rates) && ok; r = r + 1)
+    {
+        punctureInitStandard(puncture, (ePuncture)r);
+
+        double start = now();
+        unsigned int puncLen = punctureWord(puncture, code, codeLen, punctured);
+        double wordTime = now() - start;
+        start = now();
+        unsigned int packedLen = puncturePacked(puncture, packedCode, codeLen, packedPunctured);
+        double packedTime = now() - start;
+        start = now();
+        depunctureWord(puncture, punctured, puncLen, restored, codeLen);
+        double depunctureTime = now() - start;
+
+        packBits(punctured, puncLen, false, expected);
+        ok = (packedLen == puncLen) && !memcmp(expected, packedPunctured, (puncLen + 7) / 8);
+
+        unsigned int frame = 400;                           //проверка декодирования восстановленного кадра без ошибок канала
+        getCodeWordTailBiting(word, frame, code, N*frame);
+        unsigned int frameLen = punctureWord(puncture, code, N*frame, punctured);
+        depunctureWord(puncture, punctured, frameLen, restored, N*frame);
+        ok = ok && getDecodeTailBiting(restored, N*frame, decoded, frame)
+                && !memcmp(word, decoded, frame * sizeof(unsigned int));
+        getCodeWordTailBiting(word, len, code, codeLen);
+
+        printf("puncture %-10s kept %5.3f  punctureWord %7.1f Msym/s  puncturePacked %7.1f Msym/s  depunctureWord %7.1f Msym/s\n",
+               names[r], (double)puncLen / codeLen, codeLen / wordTime * 1e-6,
+               codeLen / packedTime * 1e-6, codeLen / depunctureTime * 1e-6);
+        if(!ok)
+        {
+            printf("puncture %s: packed/unpacked mismatch or decode failure\n", names[r]);
+        }
+    }
+    free(word); free(code); free(punctured); free(restored); free(decoded);
+    free(packedCode); free(packedPunctured); free(expected); free(puncture);
+    return ok;
+}
+
+/**
+ * @brief замер построения решеток по порождающим многочленам и проверка
+ *        кодирования и декодирования несколькими кодами
+ * @param
+ */
+static bool benchTrellis(void)
+{
+    const sCodeSpec *specs[] = {&ituCode, &ccsdsCode, &k9Rate13Code};
+    const char *names[] = {"ITU-T K=7 171/133", "CCSDS K=7 171/133~", "K=9 r1/3 557/663/711"};
+    unsigned int len = 2000;                                //длина слова
+    unsigned int word[2000], decoded[2000];
+    unsigned int *code = malloc(MAX_OUTPUTS * (len + MAX_K) * sizeof(unsigned int));
+    unsigned int *reference = malloc(N * (len + SIZE) * sizeof(unsigned int));
+    unsigned int c;
+    for(c = 0; c < sizeof(specs) / sizeof(specs[0]); c = c + 1)
+    {
+        sTrellis trellis;
+        unsigned int repeat = 1000;
+        unsigned int r;
+        double start = now();
+        for(r = 0; r < repeat; r = r + 1)
+        {
+            buildTrellis(&trellis, specs[c]);
+            freeTrellis(&trellis);
+        }
+        double buildTime = (now() - start) / repeat;
+        buildTrellis(&trellis, specs[c]);
+
+        unsigned int codeLen = specs[c]->outputs * (len + specs[c]->K - 2);
+        randomWord(word, len);
+        trellisEncode(&trellis, word, len, code, codeLen);
+        if(c == 0)                                          //для ITU-T кодирование совпадает с getCodeWord
+        {
+            getCodeWord(word, len, reference, codeLen);
+            if(memcmp(code, reference, codeLen * sizeof(unsigned int)))
+            {
+                printf("trellisEncode: mismatch with getCodeWord\n");
+                return false;
+            }
+        }
+        channel(code, codeLen, 0.03);
+        start = now();
+        if(!trellisDecode(&trellis, code, codeLen, decoded, len))
+        {
+            printf("trellisDecode: out of memory\n");
+            return false;
+        }
+        double decodeTime = now() - start;
+        unsigned int errors = 0, i;
+        for(i = 0; i < len; i = i + 1)
+        {
+            errors += word[i] != decoded[i];
+        }
+        printf("trellis  %-22s build %7.2f us  decode %6.2f Mbit/s  BER %.4f at p=0.03\n",
+               names[c], buildTime * 1e6, len / decodeTime * 1e-6, (double)errors / len);
+        freeTrellis(&trellis);
+    }
+
+    double start = now();
+    initTablesFor(&ituCode);
+    printf("trellis  initTablesFor(ituCode) incl. byte tables %.2f us\n", (now() - start) * 1e6);
+    free(code);
+    free(reference);
+    return true;
+}
+
+/**
+ * @brief запись таблицы в текстовый файл (формат getTable)
+ * @param
+ *  filename - имя файла
+ *  rows, cols - размеры таблицы
+ *  value - функция получения элемента таблицы
+ */
+static bool writeTextTable(const char *filename, unsigned int rows, unsigned int cols,
+                           int (*value)(unsigned int row, unsigned int col))
+{
+    FILE *file = fopen(filename, "w");
+    unsigned int i, j;
+    if(file == NULL)
+    {
+        return false;
+    }
+    for(i = 0; i < rows; i = i + 1)
+    {
+        for(j = 0; j < cols; j = j + 1)
+        {
+            fprintf(file, "%d ", value(i, j));
+        }
+        fprintf(file, "\n");
+    }
+    return fclose(file) == 0;
+}
+
+static int stateValue(unsigned int row, unsigned int col) { return stateTable[row][col]; }
+static int codeValue(unsigned int row, unsigned int col) { return codeTable[row][col]; }
+static int jumpValue(unsigned int row, unsigned int col) { return jumpTable[row][col]; }
+
+/**
+ * @brief замер времени загрузки таблиц при запуске: текстовые таблицы (getTable)
+ *        против двоичных файлов решетки, отображаемых в память (loadTrellis)
+ * @param
+ */
+static bool benchStartup(void)
+{
+    const sCodeSpec *specs[] = {&ituCode, &ccsdsCode, &k9Rate13Code};
+    char textNames[3][64], binNames[3][64];                 //временные файлы
+    static int states[S][SIZE], codes[S][N], jumps[S][S];   //таблицы, прочитанные из текста
+    unsigned int repeat = 200;
+    unsigned int c, r;
+    bool ok = true;
+
+    initTablesFor(&ituCode);
+    for(c = 0; c < 3; c = c + 1)
+    {
+        sTrellis trellis;
+        snprintf(textNames[c], sizeof(textNames[c]), "/tmp/convcoder_%d_%u.txt", (int)getpid(), c);
+        snprintf(binNames[c], sizeof(binNames[c]), "/tmp/convcoder_%d_%u.trellis", (int)getpid(), c);
+        buildTrellis(&trellis, specs[c]);
+        ok = ok && saveTrellis(&trellis, binNames[c]);
+        freeTrellis(&trellis);
+    }
+    ok = ok && writeTextTable(textNames[0], S, SIZE, stateValue)
+            && writeTextTable(textNames[1], S, N, codeValue)
+            && writeTextTable(textNames[2], S, S, jumpValue);
+    if(!ok)
+    {
+        printf("startup: can't write temporary files\n");
+        return false;
+    }
+
+    //проверка: текстовые таблицы читаются без искажений, двоичные совпадают с построенными
+    ok = getTable(S, SIZE, textNames[0], states) && getTable(S, N, textNames[1], codes)
+      && getTable(S, S, textNames[2], jumps);
+    unsigned int i, j;
+    for(i = 0; ok && (i < S); i = i + 1)
+    {
+        for(j = 0; j < S; j = j + 1)
+        {
+            ok = ok && (jumps[i][j] == jumpTable[i][j]) && ((j >= SIZE) || (states[i][j] == stateTable[i][j]))
+                    && ((j >= N) || (codes[i][j] == codeTable[i][j]));
+        }
+    }
+    for(c = 0; ok && (c < 3); c = c + 1)
+    {
+        sTrellis built, loaded;
+        buildTrellis(&built, specs[c]);
+        ok = loadTrellis(&loaded, binNames[c]) && (loaded.states == built.states)
+          && !memcmp(&loaded.spec, &built.spec, sizeof(sCodeSpec))
+          && !memcmp(loaded.nextState, built.nextState, 2*built.states*sizeof(uint16_t))
+          && !memcmp(loaded.prevState, built.prevState, 2*built.states*sizeof(uint16_t))
+          && !memcmp(loaded.output, built.output, 2*built.states);
+        freeTrellis(&built);
+        freeTrellis(&loaded);
+    }
+    FILE *file = fopen(binNames[2], "r+b");                 //поврежденный файл должен отвергаться
+    if(ok && file)
+    {
+        sTrellis loaded;
+        fseek(file, sizeof(sTrellisFileHeader) + 5, SEEK_SET);
+        int byte = fgetc(file);
+        fseek(file, sizeof(sTrellisFileHeader) + 5, SEEK_SET);
+        fputc(byte ^ 0xFF, file);
+        fclose(file);
+        ok = !loadTrellis(&loaded, binNames[2]) && (loaded.memory == NULL);
+        buildTrellis(&loaded, specs[2]);
+        saveTrellis(&loaded, binNames[2]);
+        freeTrellis(&loaded);
+    }
+    ok = ok && initTablesFromFile(binNames[0]);
+    if(!ok)
+    {
+        printf("startup: table files mismatch\n");
+        return false;
+    }
+
+    double start = now();
+    for(r = 0; r < repeat; r = r + 1)
+    {
+        getTable(S, SIZE, textNames[0], states);
+        getTable(S, N, textNames[1], codes);
+        getTable(S, S, textNames[2], jumps);
+    }
+    double textTime = (now() - start) / repeat;
+
+    start = now();
+    for(r = 0; r < repeat; r = r + 1)
+    {
+        sTrellis trellis;
+        loadTrellis(&trellis, binNames[0]);
+        freeTrellis(&trellis);
+    }
+    double mapTime = (now() - start) / repeat;
+
+    start = now();
+    for(r = 0; r < repeat; r = r + 1)
+    {
+        for(c = 0; c < 3; c = c + 1)
+        {
+            sTrellis trellis;
+            loadTrellis(&trellis, binNames[c]);
+            freeTrellis(&trellis);
+        }
+    }
+    double mapAllTime = (now() - start) / repeat;
+
+    start = now();
+    for(r = 0; r < repeat; r = r + 1)
+    {
+        initTablesFromFile(binNames[0]);
+    }
+    double initTime = (now() - start) / repeat;
+
+    printf("startup  text tables (getTable x3)      %8.2f us\n", textTime * 1e6);
+    printf("startup  mmap trellis ITU-T             %8.2f us  (%.1fx)\n", mapTime * 1e6, textTime / mapTime);
+    printf("startup  mmap trellis ITU+CCSDS+K9      %8.2f us\n", mapAllTime * 1e6);
+    printf("startup  initTablesFromFile incl. byte tables %.2f us\n", initTime * 1e6);
+
+    for(c = 0; c < 3; c = c + 1)
+    {
+        remove(textNames[c]);
+        remove(binNames[c]);
+    }
+    return true;
+}
+
+/**
+ * @brief главная функция
+ * @param
+ *
+ */
+int main(void)
+{
+    srand(1);
+    if(!benchPackedEncoder() || !benchPackedPipeline() || !benchSlicedEncoder(1) || !benchSlicedEncoder(4)
+       || !benchParallelEncoder() || !benchStreamEncoder() || !benchDecoder() || !benchFastPath() || !benchSyndrome() || !benchWorkspace() || !benchTreeSoak() || !benchThreads() || !benchParallelDecoder() || !benchBatch() || !benchAcs() || !benchSoft() || !benchStreamDecoder() || !benchEarly()
+       || !benchSurvivor() || !benchTailBiting() || !benchPuncture()
+       || !benchTrellis() || !benchStartup())
+    {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,608 @@
+/********************************************************************************
+* @file    suite.c
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Набор замеров производительности кодера и декодера с выводом в JSON для
+  * автоматического сравнения версий. Для каждой длины кадра (от 16 бит до
+  * 16 Мбит), вероятности ошибки в канале, глубины обратного прохода и
+  * количества потоков замеряются getCodeWord, getDecode и их ускоренные
+  * варианты. Для каждого случая выводятся скорость (Мбит/с), нс и такты на
+  * бит, медиана и 99-й процентиль времени вызова, пиковый объем резидентной
+  * памяти за время случая и количество ошибочных битов на выходе (для
+  * кодеров - расхождения с getCodeWord/getCodeWordPacked).
+  *
+  * Сборка (из корня репозитория):
+  *  gcc -std=gnu99 -O2 -pthread -iquote . bench/suite.c coder.c viterby.c tables.c puncture.c acs.c -lm -o suite
+  * Запуск: suite [-m максимальная длина кадра] [-t время случая, с] [-f подстрока имени] > results.json
+  *
+  ******************************************************************************
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <malloc.h>
+#include "coder.h"
+#include "viterby.h"
+#include "acs.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SUITE_TSC 1
+#else
+#define SUITE_TSC 0
+#endif
+
+//*******************************Макросы******************************************
+/**
+ * @brief минимальное и максимальное количество вызовов в случае
+ */
+#define SUITE_MIN_REPS 3
+#define SUITE_MAX_REPS 100000
+
+/**
+ * @brief размер части потока для потокового декодера
+ */
+#define SUITE_STREAM_PART 4096
+
+//*****************************Перечисления****************************************
+/**
+ * @brief способ проверки результата случая
+ *  CHECK_CODE - output совпадает с кодовым словом getCodeWord
+ *  CHECK_PACKED_CODE - packedOutput совпадает с кодовым словом getCodeWordPacked
+ *  CHECK_WORD - output совпадает с исходным словом
+ *  CHECK_WORD_REVERSED - output совпадает с исходным словом в обратном порядке
+ *  CHECK_PACKED_WORD - packedOutput совпадает с упакованным исходным словом
+ */
+typedef enum
+{
+    CHECK_CODE,
+    CHECK_PACKED_CODE,
+    CHECK_WORD,
+    CHECK_WORD_REVERSED,
+    CHECK_PACKED_WORD
+}eCheck;
+
+//*****************************Структуры******************************************
+/**
+ * @brief структура sFrame описывает данные кадра одной длины.
+ * Члены структуры:
+ *  len - длина исходного слова
+ *  codeLen - длина кодового слова
+ *  word - исходное слово
+ *  code - кодовое слово (getCodeWord)
+ *  noisy - кодовое слово после канала
+ *  llr - мягкие решения по noisy (0 -> +127, 1 -> -127)
+ *  output - выход кодеров и декодеров
+ *  packedWord - упакованное исходное слово
+ *  packedCode - упакованное кодовое слово (getCodeWordPacked)
+ *  packedNoisy - упакованное кодовое слово после канала
+ *  packedOutput - упакованный выход кодеров и декодеров
+ *  workspace - рабочая область getDecodeWorkspace
+ *  workspaceSize - размер рабочей области
+ */
+typedef struct
+{
+    unsigned int len;
+    unsigned int codeLen;
+    unsigned int *word;
+    unsigned int *code;
+    unsigned int *noisy;
+    int8_t *llr;
+    unsigned int *output;
+    uint8_t *packedWord;
+    uint8_t *packedCode;
+    uint8_t *packedNoisy;
+    uint8_t *packedOutput;
+    void *workspace;
+    size_t workspaceSize;
+}sFrame;
+
+struct sCase;
+
+/**
+ * @brief вызов замеряемой функции для кадра
+ */
+typedef void (*tRun)(sFrame *frame, const struct sCase *test);
+
+/**
+ * @brief структура sCase описывает случай замера.
+ * Члены структуры:
+ *  name - название (замеряемая функция)
+ *  run - вызов функции
+ *  check - способ проверки результата
+ *  frames - количество кадров за вызов
+ *  errorRate - вероятность ошибки в канале (меньше 0 - для кодеров)
+ *  depth - глубина обратного прохода (0 - не задается)
+ *  threads - количество потоков
+ */
+typedef struct sCase
+{
+    const char *name;
+    tRun run;
+    eCheck check;
+    unsigned int frames;
+    double errorRate;
+    unsigned int depth;
+    unsigned int threads;
+}sCase;
+
+//**************************Переменные*******************************************
+static double minTime = 0.05;               //минимальное время случая, с
+static const char *filter = NULL;           //подстрока названий замеряемых случаев
+static bool rssReset = false;               //пиковый объем памяти сбрасывается перед случаем
+static bool firstResult = true;
+static double samples[SUITE_MAX_REPS];      //время вызовов случая
+
+/**
+ * @brief текущее время в секундах
+ * @param
+ */
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief счетчик тактов процессора (TSC) или 0, если его нет
+ * @param
+ */
+static uint64_t cycles(void)
+{
+#if SUITE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief сброс пикового объема резидентной памяти процесса (Linux)
+ * @param
+ * @return true при успешном сбросе
+ */
+static bool resetPeakRss(void)
+{
+    FILE *file = fopen("/proc/self/clear_refs", "w");
+    if(!file)
+    {
+        return false;
+    }
+    bool done = (fputs("5", file) >= 0);
+    return (fclose(file) == 0) && done;
+}
+
+/**
+ * @brief пиковый объем резидентной памяти процесса в КБ (VmHWM)
+ * @param
+ */
+static unsigned long peakRss(void)
+{
+    char line[128];
+    unsigned long peak = 0;
+    FILE *file = fopen("/proc/self/status", "r");
+    if(!file)
+    {
+        return 0;
+    }
+    while(fgets(line, sizeof(line), file))
+    {
+        if(sscanf(line, "VmHWM: %lu", &peak) == 1)
+        {
+            break;
+        }
+    }
+    fclose(file);
+    return peak;
+}
+
+static int compareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief двоичный симметричный канал для упакованного слова: каждый бит
+ *        инвертируется с вероятностью p
+ * @param
+ *  packed - упакованное слово
+ *  bits - длина слова в битах
+ *  p - вероятность ошибки
+ */
+static void packedChannel(uint8_t *packed, unsigned int bits, double p)
+{
+    unsigned int i;
+    for(i = 0; i < bits; i = i + 1)
+    {
+        if(rand() < p * RAND_MAX)
+        {
+            packed[i / 8] ^= 0x80 >> (i % 8);
+        }
+    }
+}
+
+/**
+ * @brief выделение и заполнение кадра длины len; при нехватке памяти набор
+ *        завершается с сообщением и ненулевым кодом
+ * @param
+ *  frame - кадр
+ *  len - длина исходного слова
+ */
+static void frameInit(sFrame *frame, unsigned int len)
+{
+    unsigned int i;
+    frame->len = len;
+    frame->codeLen = N*(len + SIZE-1);
+    frame->word = malloc(len * sizeof(unsigned int));
+    frame->code = malloc(frame->codeLen * sizeof(unsigned int));
+    frame->noisy = malloc(frame->codeLen * sizeof(unsigned int));
+    frame->llr = malloc(frame->codeLen);
+    frame->output = malloc((frame->codeLen + 2*DECODER_MAX_DEPTH) * sizeof(unsigned int));
+    frame->packedWord = calloc((len + 7) / 8, 1);
+    frame->packedCode = malloc((frame->codeLen + 7) / 8);
+    frame->packedNoisy = malloc((frame->codeLen + 7) / 8);
+    frame->packedOutput = malloc((frame->codeLen + 7) / 8);
+    frame->workspaceSize = getDecodeWorkspaceSize(frame->codeLen, DECODE_HARD);
+    if(posix_memalign(&frame->workspace, DECODE_WORKSPACE_ALIGN, frame->workspaceSize) != 0)
+    {
+        frame->workspace = NULL;
+    }
+    if(!frame->word || !frame->code || !frame->noisy || !frame->llr || !frame->output || !frame->packedWord ||
+       !frame->packedCode || !frame->packedNoisy || !frame->packedOutput || !frame->workspace)
+    {
+        fprintf(stderr, "Error! Out of memory for a frame of %u bits\n", len);
+        exit(1);
+    }
+    for(i = 0; i < len; i = i + 1)
+    {
+        frame->word[i] = rand() & 1;
+        frame->packedWord[i / 8] |= frame->word[i] << (7 - i % 8);
+    }
+    getCodeWord(frame->word, len, frame->code, frame->codeLen);
+    getCodeWordPacked(frame->packedWord, len, frame->packedCode);
+}
+
+/**
+ * @brief передача кодовых слов кадра через канал с вероятностью ошибки p
+ * @param
+ *  frame - кадр
+ *  p - вероятность ошибки
+ */
+static void frameChannel(sFrame *frame, double p)
+{
+    unsigned int i;
+    for(i = 0; i < frame->codeLen; i = i + 1)
+    {
+        frame->noisy[i] = frame->code[i] ^ (rand() < p * RAND_MAX);
+        frame->llr[i] = frame->noisy[i] ? -127 : 127;
+    }
+    memcpy(frame->packedNoisy, frame->packedCode, (frame->codeLen + 7) / 8);
+    packedChannel(frame->packedNoisy, frame->codeLen, p);
+}
+
+static void frameFree(sFrame *frame)
+{
+    free(frame->word);
+    free(frame->code);
+    free(frame->noisy);
+    free(frame->llr);
+    free(frame->output);
+    free(frame->packedWord);
+    free(frame->packedCode);
+    free(frame->packedNoisy);
+    free(frame->packedOutput);
+    free(frame->workspace);
+}
+
+static void runCodeWord(sFrame *frame, const sCase *test)
+{
+    (void)test;
+    getCodeWord(frame->word, frame->len, frame->output, frame->codeLen);
+}
+
+static void runCodeWordPacked(sFrame *frame, const sCase *test)
+{
+    (void)test;
+    getCodeWordPacked(frame->packedWord, frame->len, frame->packedOutput);
+}
+
+static void runCodeWordParallel(sFrame *frame, const sCase *test)
+{
+    getCodeWordParallel(frame->word, frame->len, frame->output, frame->codeLen, test->threads,
+                        (frame->len + test->threads - 1) / test->threads);
+}
+
+static void runCodeWordPackedParallel(sFrame *frame, const sCase *test)
+{
+    unsigned int bytes = (frame->len + 7) / 8;
+    getCodeWordPackedParallel(frame->packedWord, frame->len, frame->packedOutput, test->threads,
+                              (bytes + test->threads - 1) / test->threads);
+}
+
+static void runDecode(sFrame *frame, const sCase *test)
+{
+    (void)test;
+    getDecode(frame->noisy, frame->codeLen, frame->output, frame->len);
+}
+
+static void runDecodeSyndrome(sFrame *frame, const sCase *test)
+{
+    (void)test;
+    getDecodeSyndrome(frame->noisy, frame->codeLen, frame->output, frame->len);
+}
+
+static void runDecodeSoft(sFrame *frame, const sCase *test)
+{
+    (void)test;
+    getDecodeSoft(frame->llr, frame->codeLen, frame->output, frame->len);
+}
+
+static void runDecodePacked(sFrame *frame, const sCase *test)
+{
+    (void)test;
+    getDecodePacked(frame->packedNoisy, frame->codeLen, frame->packedOutput, frame->len, BIT_ORDER_MSB);
+}
+
+static void runDecodeWorkspace(sFrame *frame, const sCase *test)
+{
+    (void)test;
+    getDecodeWorkspace(frame->noisy, frame->codeLen, DECODE_HARD, frame->output, frame->len,
+                       frame->workspace, frame->workspaceSize);
+}
+
+static void runDecodeParallel(sFrame *frame, const sCase *test)
+{
+    getDecodeParallel(frame->noisy, frame->codeLen, frame->output, frame->len, test->threads, 0, DECODER_DEPTH);
+}
+
+static void runDecodeBatch(sFrame *frame, const sCase *test)
+{
+    unsigned int *codeWords[ACS_LANES];     //все кадры пакета - один и тот же кадр
+    unsigned int *decodeWords[ACS_LANES];
+    unsigned int i;
+    (void)test;
+    for(i = 0; i < ACS_LANES; i = i + 1)
+    {
+        codeWords[i] = frame->noisy;
+        decodeWords[i] = frame->output;
+    }
+    getDecodeBatch(codeWords, ACS_LANES, frame->codeLen, decodeWords, frame->len);
+}
+
+static void runDecoderStream(sFrame *frame, const sCase *test)
+{
+    sDecoder decoder;
+    unsigned int got = 0;                   //количество выданных символов
+    unsigned int offset;                    //начало очередной части потока
+    decoderInit(&decoder, test->depth);
+    for(offset = 0; offset < frame->codeLen; offset = offset + SUITE_STREAM_PART)
+    {
+        unsigned int part = (frame->codeLen - offset < SUITE_STREAM_PART) ? (frame->codeLen - offset)
+                                                                          : SUITE_STREAM_PART;
+        got = got + decoderPush(&decoder, frame->noisy + offset, part, frame->output + got);
+    }
+    decoderFlush(&decoder, frame->output + got);
+}
+
+/**
+ * @brief количество ошибочных символов результата случая
+ * @param
+ *  frame - кадр
+ *  check - способ проверки
+ */
+static unsigned long countErrors(const sFrame *frame, eCheck check)
+{
+    unsigned long errors = 0;
+    unsigned int i;
+    switch(check)
+    {
+    case CHECK_CODE:
+        for(i = 0; i < frame->codeLen; i = i + 1)
+        {
+            errors = errors + (frame->output[i] != frame->code[i]);
+        }
+        break;
+    case CHECK_PACKED_CODE:
+        for(i = 0; i < frame->codeLen; i = i + 1)
+        {
+            errors = errors + (((frame->packedOutput[i / 8] ^ frame->packedCode[i / 8]) >> (7 - i % 8)) & 1);
+        }
+        break;
+    case CHECK_WORD:
+        for(i = 0; i < frame->len; i = i + 1)
+        {
+            errors = errors + (frame->output[i] != frame->word[i]);
+        }
+        break;
+    case CHECK_WORD_REVERSED:
+        for(i = 0; i < frame->len; i = i + 1)
+        {
+            errors = errors + (frame->output[frame->len - 1 - i] != frame->word[i]);
+        }
+        break;
+    case CHECK_PACKED_WORD:
+        for(i = 0; i < frame->len; i = i + 1)
+        {
+            errors = errors + (((frame->packedOutput[i / 8] ^ frame->packedWord[i / 8]) >> (7 - i % 8)) & 1);
+        }
+        break;
+    }
+    return errors;
+}
+
+/**
+ * @brief замер случая и вывод результата (элемент массива results).
+ *        Функция вызывается не менее SUITE_MIN_REPS раз и не меньше minTime
+ *        секунд; первый (прогревочный) вызов не учитывается
+ * @param
+ *  frame - кадр
+ *  test - случай
+ */
+static void measure(sFrame *frame, const sCase *test)
+{
+    unsigned int reps = 0;                  //количество учтенных вызовов
+    double total = 0;                       //суммарное время вызовов
+    uint64_t ticks = 0;                     //суммарное количество тактов
+    unsigned long errors;
+
+    if(filter && !strstr(test->name, filter))
+    {
+        return;
+    }
+    resetPeakRss();
+    test->run(frame, test);                 //прогрев: таблицы, страницы буферов
+    errors = countErrors(frame, test->check);
+    while(((reps < SUITE_MIN_REPS) || (total < minTime)) && (reps < SUITE_MAX_REPS))
+    {
+        uint64_t startTicks = cycles();
+        double start = now();
+        test->run(frame, test);
+        samples[reps] = now() - start;
+        ticks = ticks + (cycles() - startTicks);
+        total = total + samples[reps];
+        reps = reps + 1;
+    }
+    unsigned long rss = peakRss();
+    qsort(samples, reps, sizeof(double), compareDouble);
+
+    double bits = (double)frame->len * test->frames * reps;   //исходных битов за все вызовы
+    printf("%s\n    {\"name\": \"%s\", \"bits\": %u, \"frames\": %u, ", firstResult ? "" : ",",
+           test->name, frame->len, test->frames);
+    if(test->errorRate < 0)
+    {
+        printf("\"error_rate\": null, ");
+    }
+    else
+    {
+        printf("\"error_rate\": %g, ", test->errorRate);
+    }
+    if(test->depth)
+    {
+        printf("\"depth\": %u, ", test->depth);
+    }
+    else
+    {
+        printf("\"depth\": null, ");
+    }
+    printf("\"threads\": %u, \"reps\": %u, \"mbit_s\": %.6g, \"ns_per_bit\": %.6g, ",
+           test->threads, reps, bits / total * 1e-6, total / bits * 1e9);
+    if(SUITE_TSC)
+    {
+        printf("\"cycles_per_bit\": %.6g, ", ticks / bits);
+    }
+    else
+    {
+        printf("\"cycles_per_bit\": null, ");
+    }
+    printf("\"latency_p50_us\": %.6g, \"latency_p99_us\": %.6g, \"peak_rss_kb\": %lu, \"bit_errors\": %lu}",
+           samples[(reps - 1) * 50 / 100] * 1e6, samples[(reps - 1) * 99 / 100] * 1e6, rss, errors);
+    firstResult = false;
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int lens[] = {16, 256, 4096, 65536, 1 << 20, 1 << 24};    //длины кадров
+    double errors[] = {0.0, 1e-3, 1e-2};                                //вероятности ошибки в канале
+    unsigned int depths[] = {2*(SIZE+1), DECODER_DEPTH, 64, 128, DECODER_MAX_DEPTH};
+    unsigned int threads[] = {1, 2, 4, 8};
+    unsigned int maxBits = 1 << 24;         //наибольшая длина кадра
+    unsigned int l, e, i;
+    int opt;
+
+    while((opt = getopt(argc, argv, "m:t:f:")) != -1)
+    {
+        switch(opt)
+        {
+        case 'm':
+            maxBits = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            minTime = strtod(optarg, NULL);
+            break;
+        case 'f':
+            filter = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-m max frame bits] [-t min seconds per case] [-f name filter]\n", argv[0]);
+            return 2;
+        }
+    }
+    srand(1);
+    mallopt(M_MMAP_THRESHOLD, 128*1024);    //большие буферы всегда возвращаются системе: пик памяти относится к случаю
+    initTables();
+    rssReset = resetPeakRss();
+
+    printf("{\n  \"suite\": \"convcoder\",\n  \"schema\": 1,\n  \"acs_kernel\": \"%s\",\n", acsKernelName(acsKernel()));
+    printf("  \"cpus\": %ld,\n  \"min_time_s\": %g,\n  \"tsc\": %s,\n  \"rss_per_case\": %s,\n  \"results\": [",
+           sysconf(_SC_NPROCESSORS_ONLN), minTime, SUITE_TSC ? "true" : "false", rssReset ? "true" : "false");
+
+    for(l = 0; (l < sizeof(lens) / sizeof(lens[0])) && (lens[l] <= maxBits); l = l + 1)
+    {
+        sFrame frame;
+        unsigned int len = lens[l];
+        frameInit(&frame, len);
+
+        sCase encoders[] =
+        {
+            {"getCodeWord",       runCodeWord,       CHECK_CODE,        1, -1, 0, 1},
+            {"getCodeWordPacked", runCodeWordPacked, CHECK_PACKED_CODE, 1, -1, 0, 1}
+        };
+        for(i = 0; i < sizeof(encoders) / sizeof(encoders[0]); i = i + 1)
+        {
+            measure(&frame, &encoders[i]);
+        }
+        for(i = 0; (i < sizeof(threads) / sizeof(threads[0])) && (len >= 65536); i = i + 1)
+        {
+            sCase parallel = {"getCodeWordParallel", runCodeWordParallel, CHECK_CODE, 1, -1, 0, threads[i]};
+            sCase packed = {"getCodeWordPackedParallel", runCodeWordPackedParallel, CHECK_PACKED_CODE, 1, -1, 0,
+                            threads[i]};
+            measure(&frame, &parallel);
+            measure(&frame, &packed);
+        }
+
+        for(e = 0; e < sizeof(errors) / sizeof(errors[0]); e = e + 1)
+        {
+            double p = errors[e];
+            frameChannel(&frame, p);
+            sCase decoders[] =
+            {
+                {"getDecode",          runDecode,          CHECK_WORD,        1, p, 0, 1},
+                {"getDecodeSyndrome",  runDecodeSyndrome,  CHECK_WORD,        1, p, 0, 1},
+                {"getDecodeWorkspace", runDecodeWorkspace, CHECK_WORD,        1, p, 0, 1},
+                {"getDecodeSoft",      runDecodeSoft,      CHECK_WORD,        1, p, 0, 1},
+                {"getDecodePacked",    runDecodePacked,    CHECK_PACKED_WORD, 1, p, 0, 1}
+            };
+            for(i = 0; i < sizeof(decoders) / sizeof(decoders[0]); i = i + 1)
+            {
+                measure(&frame, &decoders[i]);
+            }
+            if(len <= 65536)                //решения пакета - 256 байт на шаг
+            {
+                sCase batch = {"getDecodeBatch", runDecodeBatch, CHECK_WORD, ACS_LANES, p, 0, 1};
+                measure(&frame, &batch);
+            }
+            for(i = 0; (i < sizeof(threads) / sizeof(threads[0])) && (len >= 65536); i = i + 1)
+            {
+                sCase parallel = {"getDecodeParallel", runDecodeParallel, CHECK_WORD, 1, p, DECODER_DEPTH,
+                                  threads[i]};
+                measure(&frame, &parallel);
+            }
+            for(i = 0; i < sizeof(depths) / sizeof(depths[0]); i = i + 1)
+            {
+                sCase stream = {"decoderPush", runDecoderStream, CHECK_WORD_REVERSED, 1, p, depths[i], 1};
+                measure(&frame, &stream);
+            }
+        }
+        frameFree(&frame);
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
@@ -17,38 +17,106 @@
   ******************************************************************************
 */
 #include "coder.h"
-#include <string.h>
 #include <stdlib.h>
+#include <pthread.h>
+
+/**
+ * @brief признак того, что таблицы конечного автомата построены
+ */
+static bool tablesReady = false;
+
+/**
+ * @brief однократное построение таблиц по умолчанию (см. initTables)
+ */
+static pthread_once_t tablesOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief размер кольцевого буфера битово-параллельного кодера (степень двойки, не менее SIZE+1)
+ */
+#define SLICED_HISTORY 8
+
+#if SLICED_HISTORY < SIZE + 1
+#error "SLICED_HISTORY должен вмещать SIZE+1 символов"
+#endif
+
+/**
+ * @brief построение таблиц по коду ITU-T, если таблицы еще не построены
+ * @param
+ */
+static void initDefaultTables(void)
+{
+    if(!tablesReady)                                //если таблицы еще не построены
+    {
+        initTablesFor(&ituCode);
+    }
+}
 
 /**
  * @brief инициализация таблиц конечного автомата. Выполняется один раз при
- *        запуске программы
+ *        запуске программы; таблицы строятся по коду ITU-T (ituCode), если
+ *        ранее не был выбран другой код вызовом initTablesFor. Может
+ *        вызываться из нескольких потоков одновременно
  * @param
  */
 bool initTables()
 {
+    pthread_once(&tablesOnce, initDefaultTables);
+    return tablesReady;
+}
 
-    if(true)
+/**
+ * @brief построение таблиц конечного автомата по описанию кода. Таблицы общие
+ *        для процесса и перезаписываются на месте без блокировки: одновременно
+ *        действует один код, и только с K = SIZE+1 и N выходами без инверсии
+ *        (остальные коды - через trellisDecode, см. coder.h)
+ * @param
+ *  spec - описание кода (K = SIZE+1, N выходов без инверсии)
+ */
+bool initTablesFor(const sCodeSpec *spec)
+{
+    sTrellis trellis;                               //решетка кода
+    bool installed = buildTrellis(&trellis, spec) && setTables(&trellis);   //при отказе таблицы не изменены
+    if(installed)
     {
-        if(true)
-        {
-            if(true)
-            {
-                return true;
-            }
-        }
+        buildByteTables();                          //построение таблиц для побайтового кодирования
+        tablesReady = true;
     }
+    freeTrellis(&trellis);
+    return installed;
+}
 
-    return false;
+/**
+ * @brief построение таблиц конечного автомата по двоичному файлу решетки
+ *        (см. saveTrellis, tools/mktrellis.c)
+ * @param
+ *  filename - имя файла решетки (K = SIZE+1, N выходов без инверсии)
+ */
+bool initTablesFromFile(const char *filename)
+{
+    sTrellis trellis;                               //решетка кода, отображенная из файла
+    if(!loadTrellis(&trellis, filename))
+    {
+        return false;                               //установленные ранее таблицы остаются в силе
+    }
+    bool installed = (trellis.spec.K == SIZE + 1) && (trellis.spec.outputs == N)  //таблицы рассчитаны на S состояний
+                  && setTables(&trellis);
+    if(installed)
+    {
+        buildByteTables();                          //построение таблиц для побайтового кодирования
+        tablesReady = true;
+    }
+    freeTrellis(&trellis);
+    return installed;
 }
 
 /**
- * @brief получение таблиц из файла
+ * @brief получение таблиц из текстового файла (числа, разделенные пробельными символами)
  * @param
  *  filename - имя файла
  *  table - таблица
  *  cols - количество столбцов в таблице
  *  rows - количество строк в таблице
+ * @return true, если прочитаны все rows*cols чисел
  */
 bool getTable(unsigned int rows, unsigned int cols, char *filename, int table[rows][cols])
 {
@@ -57,11 +125,12 @@ bool getTable(unsigned int rows, unsigned int cols, char *filename, int table[ro
     {
         unsigned int i = 0;      //итератор строк таблицы переходов
         unsigned int j = 0;      //итератор столбцов таблицы переходов
-        while((!feof(file)) && (i < rows))  //пока не конец файла и итератор меньше количества строк таблицы
+        while(i < rows)         //пока итератор меньше количества строк таблицы
         {
-            char ch[N+1];            //строка для считывания символов   // пофикшен баг, было ch[N]
-            fscanf(file, "%s", ch); //чтение строки символов из файла
-            table[i][j] = atoi(ch); //перевод строки в число
+            if(fscanf(file, "%d", &table[i][j]) != 1)   //чтение числа (любой длины) из файла
+            {
+                break;              //конец файла или не число
+            }
             j = j + 1;              //увеличение итератора столбца
             if(j > cols - 1)        //если итератор столбца больше cols - 1
             {
@@ -71,7 +140,7 @@ bool getTable(unsigned int rows, unsigned int cols, char *filename, int table[ro
         }
 
         fclose(file);   //закрытие файла
-        return true;
+        return i == rows;
     }
     else
     {
@@ -80,6 +149,57 @@ bool getTable(unsigned int rows, unsigned int cols, char *filename, int table[ro
     }
 }
 
+/**
+ * @brief кодирование участка слова: сдвиги регистра с номерами [first, last).
+ *        На сдвиге i в регистр подается символ inputWord[wordLen-1-i], после
+ *        конца слова - нули. Кодовые символы сдвига i записываются в позиции
+ *        N*i .. N*i+N-1 кодового слова (в пределах codeLen)
+ * @param
+ *  inputWord - указатель на исходное слово
+ *  wordLen  - длина исходного слова
+ *  first - номер первого сдвига участка
+ *  last - номер сдвига, следующего за последним сдвигом участка
+ *  state - состояние конечного автомата перед сдвигом first
+ *  codeWord - указатель на кодированное слово
+ *  codeLen - длина кодированного слова
+ */
+static void encodeRange(const unsigned int *inputWord, unsigned int wordLen,
+                        unsigned int first, unsigned int last, unsigned int state,
+                        unsigned int *codeWord, unsigned int codeLen)
+{
+    unsigned int j = N*first;               //итератор по закодированному слову
+    unsigned int i;                         //итератор по сдвигам регистра
+    int iterator = wordLen - 1 - first;     //итератор для работы с входным словом в обратном порядке
+
+    for (i = first; i < last; ++i)
+    {
+        unsigned int bit = 0;                                       //символ, помещаемый в регистр (после конца слова - ноль)
+        if(iterator >= 0)                                           //если входное слово еще не закончилось
+        {
+            bit = (inputWord[iterator] != 0);                       //i-й символ входного слова
+        }
+
+        if(j + N <= codeLen)                                        //если в кодовом слове есть место для N символов
+        {
+            uint8_t code = outputTable[state][bit];                 //упакованный выходной код перехода
+            unsigned int k;                                         //итератор по кодовым символам
+            for(k = 0; k < N; k = k + 1)
+            {
+                codeWord[j + k] = (code >> (N - 1 - k)) & 1;        //распаковка кодового символа
+            }
+            j = j + N;
+            state = nextStateTable[state][bit];                     //переход в новое состояние
+        }
+        else
+        {
+            unsigned int codeState[N];                              //закодированный символ входного слова
+            getCodeSymbol(bit, &state, codeState);                  //получение закодрованного символа входного слова
+            addToCodeWord(codeWord, codeLen, &j, codeState);        //добавление оставшихся кодовых символов в выходное кодовое слово
+        }
+        iterator = iterator - 1;                                    //уменьшение итератора на единицу
+    }
+}
+
 /**
  * @brief запрос закодированного слова
  * @param
@@ -90,61 +210,633 @@ bool getTable(unsigned int rows, unsigned int cols, char *filename, int table[ro
  */
 void getCodeWord(unsigned int *inputWord, unsigned int wordLen, unsigned int *codeWord, unsigned int codeLen)
 {
-    initArray(coderRegister, SIZE);         //инициализация регистра кодера
+    initTables();                           //построение таблиц конечного автомата при первом вызове
     unsigned int len = wordLen + SIZE-1;    //расчет количества сдвигов регистра
-    unsigned int state = 0;                 //установка конечного автомата в начальное состояние
-    unsigned int j = 0;                     //инициализация итератора по закодированному слову
-    unsigned int i;                         //итератор по возможному количеству сдвигов регистра
-    int iterator = wordLen - 1;             //инизиализация итератора для работы с входным словом в обратном порядке
+    encodeRange(inputWord, wordLen, 0, len, 0, codeWord, codeLen);  //кодирование из начального (нулевого) состояния
+}
+
+/**
+ * @brief запрос закодированного слова с циклическим завершением (tail-biting).
+ *        Регистр заранее заполняется последними SIZE символами слова, поэтому
+ *        начальное и конечное состояния кодера совпадают и нулевой хвост не нужен:
+ *        кодовое слово имеет длину N*wordLen. Порядок подачи символов как в getCodeWord
+ * @param
+ *  inputWord - указатель на исходное слово
+ *  wordLen  - длина исходного слова
+ *  codeWord - указатель на кодированное слово
+ *  codeLen - длина кодированного слова
+ */
+void getCodeWordTailBiting(unsigned int *inputWord, unsigned int wordLen,
+                           unsigned int *codeWord, unsigned int codeLen)
+{
+    initTables();                           //построение таблиц конечного автомата при первом вызове
+    if(wordLen == 0)
+    {
+        return;
+    }
+    unsigned int state = 0;                 //состояние после подачи всего слова
+    unsigned int k;                         //итератор по разрядам регистра
+    for(k = 0; k < SIZE; k = k + 1)         //последним подается inputWord[0], он попадает в младший разряд
+    {
+        state |= (inputWord[k % wordLen] != 0) << k;
+    }
+    encodeRange(inputWord, wordLen, 0, wordLen, state, codeWord, codeLen);
+}
+
+/**
+ * @brief побайтовое кодирование полных байт упакованного слова
+ * @param
+ *  inputWord - указатель на первый кодируемый байт
+ *  bytes - количество кодируемых байт
+ *  state - состояние конечного автомата перед первым байтом
+ *  codeWord - указатель на место записи кодовых символов (N байт на входной байт)
+ * @return состояние конечного автомата после последнего байта
+ */
+static unsigned int encodeBytes(const uint8_t *inputWord, unsigned int bytes,
+                                unsigned int state, uint8_t *codeWord)
+{
+    unsigned int i;                                             //итератор по байтам входного слова
+    for(i = 0; i < bytes; i = i + 1)
+    {
+        uint16_t code = byteOutputTable[state][inputWord[i]];   //8*N кодовых символов на входной байт
+        codeWord[N*i] = code >> 8;
+        codeWord[N*i + 1] = code & 0xFF;
+        state = byteNextStateTable[state][inputWord[i]];        //переход в новое состояние
+    }
+    return state;
+}
 
-    for (i = 0; i < len; ++i)
+/**
+ * @brief кодирование хвоста упакованного слова: rest старших бит байта
+ *        inputWord[0] и SIZE-1 нулевых символов
+ * @param
+ *  inputWord - указатель на неполный последний байт слова
+ *  rest - количество оставшихся символов входного слова (меньше 8)
+ *  state - состояние конечного автомата перед хвостом
+ *  codeWord - указатель на место записи кодовых символов
+ */
+static void encodeTail(const uint8_t *inputWord, unsigned int rest,
+                       unsigned int state, uint8_t *codeWord)
+{
+    uint32_t acc = 0;                       //накопитель кодовых символов
+    unsigned int accBits = 0;               //количество символов в накопителе
+    unsigned int pos = 0;                   //итератор по байтам кодового слова
+    unsigned int i;                         //итератор по символам хвоста
+    for(i = 0; i < rest + SIZE-1; i = i + 1)    //досылка остатка слова и SIZE-1 нулевых символов
     {
-        if(iterator < 0)                                            //если итератор меньше длины входного слова
+        unsigned int bit = 0;
+        if(i < rest)
         {
-            shiftLeft(coderRegister, SIZE, 0);                      //сдвиг регистра с добавлением нуля в начало
+            bit = (inputWord[0] >> (7 - i)) & 1;
         }
-        else
+        acc = (acc << N) | outputTable[state][bit];
+        accBits = accBits + N;
+        state = nextStateTable[state][bit];
+        if(accBits >= 8)                    //если в накопителе набрался байт
         {
-            shiftLeft(coderRegister, SIZE, inputWord[iterator]);    //сдвиг регистра с добавлением i-го символа входного слова в начало
+            accBits = accBits - 8;
+            codeWord[pos] = (acc >> accBits) & 0xFF;
+            pos = pos + 1;
         }
+    }
+    if(accBits > 0)                         //запись неполного последнего байта
+    {
+        codeWord[pos] = (acc << (8 - accBits)) & 0xFF;
+    }
+}
 
-        int codeState[N];                                   //закодированный символ входного слова
-        getCodeSymbol(coderRegister, &state, codeState);    //получение закодрованного символа входного слова
-        addToCodeWord(codeWord, codeLen, &j, codeState);    //добавление новых кодовых символов в выходное кодовое слово
-        iterator = iterator - 1;                            //уменьшение итератора на единицу
+/**
+ * @brief состояние конечного автомата перед байтом byteIndex упакованного слова.
+ *        Состояние зависит только от SIZE символов, поданных перед этим байтом
+ * @param
+ *  inputWord - указатель на упакованное слово
+ *  byteIndex - номер байта
+ */
+static unsigned int packedStateBefore(const uint8_t *inputWord, unsigned int byteIndex)
+{
+    if(byteIndex == 0)                      //перед началом слова регистр обнулен
+    {
+        return 0;
     }
+    return inputWord[byteIndex - 1] & (S - 1);  //последний поданный символ - младший бит предыдущего байта
 }
 
 /**
- * @brief запрос закодированного символа
+ * @brief запрос закодированного слова в упакованном виде (побайтовое кодирование).
+ *        Символы входного слова упакованы по 8 в байт, старший бит байта подается
+ *        в кодер первым, т.е. биты идут в порядке поступления в регистр. Кодовое
+ *        слово упаковывается так же и, как и в getCodeWord, дополняется
+ *        SIZE-1 нулевыми символами на входе кодера
  * @param
- *  registerState - текущее состояние регистра кодера
- *  state - текущее состояние конечного автомата
- *  code - массив кодовых символов
+ *  inputWord - указатель на упакованное исходное слово
+ *  wordLen - длина исходного слова в битах
+ *  codeWord - указатель на упакованное кодовое слово, не менее
+ *             (N*(wordLen + SIZE-1) + 7)/8 байт
+ */
+void getCodeWordPacked(const uint8_t *inputWord, unsigned int wordLen, uint8_t *codeWord)
+{
+    initTables();                           //построение таблиц конечного автомата при первом вызове
+    unsigned int bytes = wordLen / 8;       //количество полных байт входного слова
+    unsigned int state = encodeBytes(inputWord, bytes, 0, codeWord);
+    encodeTail(inputWord + bytes, wordLen % 8, state, codeWord + N*bytes);
+}
+
+/**
+ * @brief запрос закодированного слова в упакованном виде с заданным порядком
+ *        битов в байте (см. getCodeWordPacked). При BIT_ORDER_LSB первым в
+ *        кодер подается младший бит байта, кодовое слово упаковывается так же
+ * @param
+ *  inputWord - указатель на упакованное исходное слово
+ *  wordLen - длина исходного слова в битах
+ *  codeWord - указатель на упакованное кодовое слово, не менее
+ *             (N*(wordLen + SIZE-1) + 7)/8 байт
+ *  order - порядок битов в байтах исходного и кодового слов
  */
-void getCodeSymbol(unsigned int registerState[SIZE], unsigned int *state,
-                   unsigned int code[N])
+void getCodeWordPackedOrder(const uint8_t *inputWord, unsigned int wordLen, uint8_t *codeWord,
+                            eBitOrder order)
 {
-    int j;  //итератор по столбцам таблицы переходов
+    if(order == BIT_ORDER_MSB)
+    {
+        getCodeWordPacked(inputWord, wordLen, codeWord);
+        return;
+    }
+    initTables();                           //построение таблиц конечного автомата при первом вызове
+    unsigned int bytes = wordLen / 8;       //количество полных байт входного слова
+    unsigned int state = 0;                 //состояние конечного автомата
+    unsigned int i;                         //итератор по байтам входного слова
+    for(i = 0; i < bytes; i = i + 1)
+    {
+        uint8_t byte = bitReverseTable[inputWord[i]];
+        uint16_t code = byteOutputTable[state][byte];
+        codeWord[N*i] = bitReverseTable[code >> 8];
+        codeWord[N*i + 1] = bitReverseTable[code & 0xFF];
+        state = byteNextStateTable[state][byte];
+    }
 
-    for(j = 0; j < S; j = j + 1)
+    uint8_t last = 0;                       //неполный последний байт в порядке BIT_ORDER_MSB
+    uint8_t tail[(N*(8 + SIZE - 1) + 7) / 8];   //кодовые символы хвоста
+    unsigned int tailBytes = (N*(wordLen % 8 + SIZE - 1) + 7) / 8;
+    if(wordLen % 8)
     {
-        if(jumpTable[*state][j] > -1)   //если переход для текущего состояния неотрицательный
+        last = bitReverseTable[inputWord[bytes]];
+    }
+    encodeTail(&last, wordLen % 8, state, tail);
+    for(i = 0; i < tailBytes; i = i + 1)
+    {
+        codeWord[N*bytes + i] = bitReverseTable[tail[i]];
+    }
+}
+
+/**
+ * @brief инициализация контекста потокового кодера (обнуление регистра)
+ * @param
+ *  coder - указатель на контекст кодера
+ */
+void coderInit(sCoder *coder)
+{
+    initTables();                           //построение таблиц конечного автомата при первом вызове
+    coder->state = 0;                       //регистр кодера обнулен
+}
+
+/**
+ * @brief кодирование очередной части потока. Символы подаются в регистр в
+ *        порядке следования в массиве, кодовые символы записываются напрямую
+ *        в буфер вызывающей стороны. Регистр не сбрасывается и хвост не дописывается
+ * @param
+ *  coder - указатель на контекст кодера
+ *  input - указатель на часть потока (по символу 0/1 на элемент)
+ *  len - количество символов
+ *  codeWord - указатель на буфер кодовых символов, не менее N*len элементов
+ * @return количество записанных кодовых символов
+ */
+unsigned int coderPush(sCoder *coder, const unsigned int *input, unsigned int len,
+                       unsigned int *codeWord)
+{
+    unsigned int state = coder->state;      //локальная копия состояния
+    unsigned int i;                         //итератор по символам потока
+    for(i = 0; i < len; i = i + 1)
+    {
+        unsigned int bit = (input[i] != 0);
+        uint8_t code = outputTable[state][bit];     //упакованный выходной код перехода
+        unsigned int k;                             //итератор по кодовым символам
+        for(k = 0; k < N; k = k + 1)
         {
-            int index = jumpTable[*state][j];               //индекс состояния для текущего перехода
-            if(!memcmp(registerState, stateTable[index], SIZE))    //если текущее состояние регистра совпадает с возможным переходом в следующее состояние
+            codeWord[N*i + k] = (code >> (N - 1 - k)) & 1;
+        }
+        state = nextStateTable[state][bit];
+    }
+    coder->state = state;
+    return N*len;
+}
+
+/**
+ * @brief кодирование очередной части потока в упакованном виде (побайтово).
+ *        Старший бит байта подается в регистр первым
+ * @param
+ *  coder - указатель на контекст кодера
+ *  input - указатель на упакованную часть потока
+ *  bytes - количество байт
+ *  codeWord - указатель на буфер кодовых символов, не менее N*bytes байт
+ * @return количество записанных байт
+ */
+unsigned int coderPushPacked(sCoder *coder, const uint8_t *input, unsigned int bytes,
+                             uint8_t *codeWord)
+{
+    coder->state = encodeBytes(input, bytes, coder->state, codeWord);
+    return N*bytes;
+}
+
+/**
+ * @brief завершение потока: подача SIZE-1 нулевых символов и сброс регистра
+ * @param
+ *  coder - указатель на контекст кодера
+ *  codeWord - указатель на буфер кодовых символов, не менее N*(SIZE-1) элементов
+ * @return количество записанных кодовых символов
+ */
+unsigned int coderFlush(sCoder *coder, unsigned int *codeWord)
+{
+    unsigned int zeros[SIZE-1] = {0};       //хвост из нулевых символов
+    unsigned int count = coderPush(coder, zeros, SIZE-1, codeWord);
+    coder->state = 0;                       //следующий кадр начинается с обнуленного регистра, как в getCodeWord
+    return count;
+}
+
+/**
+ * @brief завершение потока в упакованном виде: N*(SIZE-1) кодовых символов,
+ *        последний байт дополняется нулями
+ * @param
+ *  coder - указатель на контекст кодера
+ *  codeWord - указатель на буфер, не менее (N*(SIZE-1) + 7)/8 байт
+ * @return количество записанных байт
+ */
+unsigned int coderFlushPacked(sCoder *coder, uint8_t *codeWord)
+{
+    encodeTail(NULL, 0, coder->state, codeWord);
+    coder->state = 0;                       //следующий кадр начинается с обнуленного регистра
+    return (N*(SIZE-1) + 7) / 8;
+}
+
+/**
+ * @brief задание потока параллельного кодирования
+ * Члены структуры:
+ *  inputWord, wordLen - исходное слово (по символу на элемент)
+ *  codeWord, codeLen - кодовое слово (по символу на элемент)
+ *  packedInput, packedCode - исходное и кодовое слова в упакованном виде
+ *  len - общее количество сдвигов регистра (символов или байт для упакованного слова)
+ *  chunkSize - размер участка, кодируемого за один раз
+ *  first - номер первого участка потока
+ *  step - шаг по участкам (количество потоков)
+ */
+typedef struct
+{
+    const unsigned int *inputWord;
+    unsigned int wordLen;
+    unsigned int *codeWord;
+    unsigned int codeLen;
+    const uint8_t *packedInput;
+    uint8_t *packedCode;
+    unsigned int len;
+    unsigned int chunkSize;
+    unsigned int first;
+    unsigned int step;
+}sEncodeJob;
+
+/**
+ * @brief поток параллельного кодирования слова (по символу на элемент).
+ *        Состояние перед участком восстанавливается по SIZE предшествующим символам
+ * @param
+ *  arg - указатель на задание sEncodeJob
+ */
+static void *encodeWorker(void *arg)
+{
+    sEncodeJob *job = arg;
+    unsigned int chunk;                                     //итератор по участкам
+    for(chunk = job->first; chunk*job->chunkSize < job->len; chunk = chunk + job->step)
+    {
+        unsigned int begin = chunk*job->chunkSize;          //первый сдвиг участка
+        unsigned int end = begin + job->chunkSize;          //сдвиг, следующий за участком
+        if(end > job->len)
+        {
+            end = job->len;
+        }
+
+        unsigned int state = 0;                             //состояние перед участком
+        unsigned int k;                                     //итератор по предшествующим символам
+        for(k = 0; (k < SIZE) && (k < begin); k = k + 1)
+        {
+            unsigned int shift = begin - 1 - k;             //номер сдвига, на котором подан символ
+            if(shift < job->wordLen)
             {
-                int i;                          //итератор по таблице кодов
-                 for(i = 0; i < N; i = i + 1)    //получение кода для текущего состояния
+                state |= (job->inputWord[job->wordLen - 1 - shift] != 0) << k;
+            }
+        }
+        encodeRange(job->inputWord, job->wordLen, begin, end, state, job->codeWord, job->codeLen);
+    }
+    return NULL;
+}
+
+/**
+ * @brief поток параллельного кодирования упакованного слова. Участки состоят
+ *        из полных байт; хвост слова кодирует поток, которому достался последний участок
+ * @param
+ *  arg - указатель на задание sEncodeJob
+ */
+static void *encodePackedWorker(void *arg)
+{
+    sEncodeJob *job = arg;
+    unsigned int bytes = job->wordLen / 8;                  //количество полных байт входного слова
+    unsigned int chunk;                                     //итератор по участкам
+    for(chunk = job->first; chunk*job->chunkSize <= bytes; chunk = chunk + job->step)
+    {
+        unsigned int begin = chunk*job->chunkSize;          //первый байт участка
+        unsigned int end = begin + job->chunkSize;          //байт, следующий за участком
+        if(end > bytes)
+        {
+            end = bytes;
+        }
+        unsigned int state = packedStateBefore(job->packedInput, begin);
+        state = encodeBytes(job->packedInput + begin, end - begin, state, job->packedCode + N*begin);
+        if(begin + job->chunkSize > bytes)                  //участок содержит конец слова
+        {
+            encodeTail(job->packedInput + bytes, job->wordLen % 8, state, job->packedCode + N*bytes);
+            break;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief запуск заданий кодирования на нескольких потоках
+ * @param
+ *  job - общее задание (поля first и step заполняются для каждого потока)
+ *  threads - количество потоков (большее MAX_THREADS уменьшается до MAX_THREADS)
+ *  worker - функция потока
+ */
+static void runEncodeJobs(const sEncodeJob *job, unsigned int threads, void *(*worker)(void *))
+{
+    pthread_t tid[MAX_THREADS];             //идентификаторы потоков
+    bool started[MAX_THREADS];              //флаги успешного создания потоков
+    sEncodeJob jobs[MAX_THREADS];           //задания потоков
+    unsigned int t;                         //итератор по потокам
+    if(threads > MAX_THREADS)               //участки распределяются по кругу, поэтому меньшее количество потоков их не теряет
+    {
+        threads = MAX_THREADS;
+    }
+    for(t = 0; t < threads; t = t + 1)
+    {
+        jobs[t] = *job;
+        jobs[t].first = t;
+        jobs[t].step = threads;
+        started[t] = (t > 0) && !pthread_create(&tid[t], NULL, worker, &jobs[t]);   //нулевое задание выполняется в вызывающем потоке
+    }
+    for(t = 0; t < threads; t = t + 1)
+    {
+        if(started[t])
+        {
+            pthread_join(tid[t], NULL);
+        }
+        else
+        {
+            worker(&jobs[t]);               //задание, для которого не удалось создать поток, выполняется на месте
+        }
+    }
+}
+
+/**
+ * @brief параллельное кодирование слова. Каждая пара кодовых символов зависит
+ *        только от текущего и SIZE предыдущих входных символов, поэтому слово
+ *        разбивается на участки, которые кодируются независимо на разных
+ *        потоках; результат совпадает с getCodeWord
+ * @param
+ *  inputWord - указатель на исходное слово
+ *  wordLen  - длина исходного слова
+ *  codeWord - указатель на кодированное слово
+ *  codeLen - длина кодированного слова
+ *  threads - количество потоков
+ *  chunkSize - количество сдвигов регистра в одном участке
+ */
+void getCodeWordParallel(unsigned int *inputWord, unsigned int wordLen,
+                         unsigned int *codeWord, unsigned int codeLen,
+                         unsigned int threads, unsigned int chunkSize)
+{
+    initTables();                           //таблицы строятся до запуска потоков
+    sEncodeJob job = {0};
+    job.inputWord = inputWord;
+    job.wordLen = wordLen;
+    job.codeWord = codeWord;
+    job.codeLen = codeLen;
+    job.len = wordLen + SIZE-1;
+    job.chunkSize = (chunkSize > 0) ? chunkSize : job.len;
+    runEncodeJobs(&job, (threads > 0) ? threads : 1, encodeWorker);
+}
+
+/**
+ * @brief параллельное кодирование упакованного слова (см. getCodeWordPacked).
+ *        Результат совпадает с getCodeWordPacked
+ * @param
+ *  inputWord - указатель на упакованное исходное слово
+ *  wordLen - длина исходного слова в битах
+ *  codeWord - указатель на упакованное кодовое слово, не менее
+ *             (N*(wordLen + SIZE-1) + 7)/8 байт
+ *  threads - количество потоков
+ *  chunkSize - количество входных байт в одном участке
+ */
+void getCodeWordPackedParallel(const uint8_t *inputWord, unsigned int wordLen, uint8_t *codeWord,
+                               unsigned int threads, unsigned int chunkSize)
+{
+    initTables();                           //таблицы строятся до запуска потоков
+    sEncodeJob job = {0};
+    job.wordLen = wordLen;
+    job.packedInput = inputWord;
+    job.packedCode = codeWord;
+    job.len = wordLen / 8;
+    job.chunkSize = (chunkSize > 0) ? chunkSize : job.len + 1;
+    runEncodeJobs(&job, (threads > 0) ? threads : 1, encodePackedWorker);
+}
+
+/**
+ * @brief битово-параллельное (bit-sliced) кодирование 64*width независимых слов.
+ *        Бит l слова inputWord[t*width + l/64] - символ t слова с номером l,
+ *        т.е. каждое слово занимает одну дорожку 64-разрядного слова, а
+ *        регистр кодера и сумматоры по модулю 2 выполняются поразрядными
+ *        операциями сразу над всеми дорожками. Для каждой дорожки результат
+ *        совпадает с getCodeWord (символы подаются с конца слова, в конце
+ *        дописываются SIZE-1 нулевых символов)
+ * @param
+ *  inputWord - указатель на входные слова, wordLen*width элементов
+ *  wordLen - длина каждого входного слова
+ *  width - количество 64-разрядных слов на один символ (1 - 64 дорожки, 4 - 256)
+ *  codeWord - указатель на кодовые слова, codeLen*width элементов
+ *  codeLen - длина каждого кодового слова
+ * @return false при нехватке памяти
+ */
+bool getCodeWordSliced(const uint64_t *inputWord, unsigned int wordLen, unsigned int width,
+                       uint64_t *codeWord, unsigned int codeLen)
+{
+    initTables();                                   //построение таблиц конечного автомата при первом вызове
+    unsigned int taps[N][SIZE + 1];                 //номера отводов каждого сумматора
+    unsigned int tapCount[N];                       //количество отводов каждого сумматора
+    unsigned int i;
+    unsigned int k;
+    for(i = 0; i < N; i = i + 1)
+    {
+        tapCount[i] = 0;
+        for(k = 0; k < SIZE + 1; k = k + 1)
+        {
+            if((generatorMask[i] >> k) & 1)
+            {
+                taps[i][tapCount[i]] = k;
+                tapCount[i] = tapCount[i] + 1;
+            }
+        }
+    }
+
+    uint64_t *history = calloc(SLICED_HISTORY * width, sizeof(uint64_t));  //кольцевой буфер последних SIZE+1 символов каждой дорожки
+    if(!history)
+    {
+        return false;
+    }
+    unsigned int len = wordLen + SIZE-1;            //расчет количества сдвигов регистра
+    unsigned int pos = 0;                           //позиция последнего символа в кольцевом буфере
+    unsigned int j = 0;                             //итератор по кодовому слову
+    int iterator = wordLen - 1;                     //символы подаются с конца слова, как в getCodeWord
+    unsigned int t;                                 //итератор по сдвигам регистра
+
+    for(t = 0; t < len; t = t + 1)
+    {
+        pos = (pos + 1) & (SLICED_HISTORY - 1);
+        uint64_t *current = history + pos*width;    //символ, помещаемый в регистр
+        unsigned int w;                             //итератор по 64-разрядным словам дорожек
+        for(w = 0; w < width; w = w + 1)
+        {
+            current[w] = (iterator >= 0) ? inputWord[iterator*width + w] : 0;
+        }
+
+        for(i = 0; (i < N) && (j < codeLen); i = i + 1)
+        {
+            uint64_t *out = codeWord + j*width;     //i-й кодовый символ всех дорожек
+            for(w = 0; w < width; w = w + 1)
+            {
+                out[w] = 0;
+            }
+            for(k = 0; k < tapCount[i]; k = k + 1)
+            {
+                const uint64_t *tap = history + ((pos - taps[i][k]) & (SLICED_HISTORY - 1))*width;
+                for(w = 0; w < width; w = w + 1)
                 {
-                    code[i] = codeTable[j][i];   // пофикшено, было codeTable[index][i], из-зв чего кодирование происходило неправильно
+                    out[w] ^= tap[w];
                 }
-                *state = index;                 //переход в новое состояние
-                return;                         //выход из функции
             }
+            j = j + 1;
         }
+        iterator = iterator - 1;
+    }
+    free(history);
+    return true;
+}
+
+/**
+ * @brief перевод набора слов в битово-параллельное представление
+ * @param
+ *  words - массив указателей на слова (по одному символу 0/1 на элемент)
+ *  count - количество слов, не более 64*width
+ *  len - длина каждого слова
+ *  width - количество 64-разрядных слов на один символ
+ *  sliced - результат, len*width элементов
+ */
+void slicedPack(unsigned int **words, unsigned int count, unsigned int len,
+                unsigned int width, uint64_t *sliced)
+{
+    unsigned int t;                                 //итератор по символам
+    for(t = 0; t < len; t = t + 1)
+    {
+        unsigned int w;                             //итератор по 64-разрядным словам
+        for(w = 0; w < width; w = w + 1)
+        {
+            uint64_t value = 0;
+            unsigned int lane;                      //итератор по дорожкам
+            for(lane = 0; (lane < 64) && (w*64 + lane < count); lane = lane + 1)
+            {
+                value |= (uint64_t)(words[w*64 + lane][t] & 1) << lane;
+            }
+            sliced[t*width + w] = value;
+        }
+    }
+}
+
+/**
+ * @brief перевод слов из битово-параллельного представления в обычное
+ * @param
+ *  sliced - слова в битово-параллельном представлении, len*width элементов
+ *  len - длина каждого слова
+ *  width - количество 64-разрядных слов на один символ
+ *  words - массив указателей на слова, куда записывается результат
+ *  count - количество слов, не более 64*width
+ */
+void slicedUnpack(const uint64_t *sliced, unsigned int len, unsigned int width,
+                  unsigned int **words, unsigned int count)
+{
+    unsigned int lane;                              //итератор по дорожкам
+    for(lane = 0; lane < count; lane = lane + 1)
+    {
+        const uint64_t *column = sliced + lane / 64;
+        unsigned int shift = lane % 64;
+        unsigned int t;                             //итератор по символам
+        for(t = 0; t < len; t = t + 1)
+        {
+            words[lane][t] = (column[t*width] >> shift) & 1;
+        }
+    }
+}
+
+/**
+ * @brief кодирование слова произвольным сверточным кодом, заданным решеткой.
+ *        Порядок подачи символов и длина хвоста (K-2 нулевых символа) как в getCodeWord
+ * @param
+ *  trellis - решетка кода (см. buildTrellis)
+ *  inputWord - указатель на исходное слово
+ *  wordLen  - длина исходного слова
+ *  codeWord - указатель на кодированное слово
+ *  codeLen - длина кодированного слова (outputs*(wordLen + K-2) для полного слова)
+ */
+void trellisEncode(const sTrellis *trellis, const unsigned int *inputWord, unsigned int wordLen,
+                   unsigned int *codeWord, unsigned int codeLen)
+{
+    unsigned int outputs = trellis->spec.outputs;   //количество выходов кода
+    unsigned int len = wordLen + trellis->spec.K - 2;   //количество сдвигов регистра
+    unsigned int state = 0;                         //начальное состояние
+    unsigned int j = 0;                             //итератор по кодовому слову
+    unsigned int i;                                 //итератор по сдвигам регистра
+    for(i = 0; (i < len) && (j < codeLen); i = i + 1)
+    {
+        unsigned int bit = (i < wordLen) ? (inputWord[wordLen - 1 - i] != 0) : 0;
+        uint8_t code = trellis->output[2*state + bit];
+        unsigned int k;                             //итератор по выходам
+        for(k = 0; (k < outputs) && (j < codeLen); k = k + 1)
+        {
+            codeWord[j] = (code >> (outputs - 1 - k)) & 1;
+            j = j + 1;
+        }
+        state = trellis->nextState[2*state + bit];
+    }
+}
+
+/**
+ * @brief запрос закодированного символа
+ * @param
+ *  bit - символ, поступающий на вход кодера
+ *  state - текущее состояние конечного автомата (упакованное состояние регистра кодера)
+ *  code - массив кодовых символов
+ */
+void getCodeSymbol(unsigned int bit, unsigned int *state, unsigned int code[N])
+{
+    uint8_t packed = outputTable[*state][bit & 1];  //упакованный выходной код перехода
+    int i;                                          //итератор по кодовым символам
+    for(i = 0; i < N; i = i + 1)
+    {
+        code[i] = (packed >> (N - 1 - i)) & 1;      //распаковка кодового символа
     }
-    printf("Error state!\n");   //сообщение об ошибке, так как переход в следующее состояние невозможен
+    *state = nextStateTable[*state][bit & 1];       //переход в новое состояние
 }
 
 /**
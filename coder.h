@@ -19,7 +19,68 @@
 #include <stdbool.h>
 #include "tables.h"
 
+//*****************************Структуры******************************************
+/**
+ * @brief структура sCoder описывает контекст потокового кодера. Состояние регистра
+ *        сохраняется между вызовами, поэтому поток можно кодировать частями по
+ *        мере поступления данных, а несколько контекстов работают независимо.
+ * Члены структуры:
+ *  state - текущее состояние конечного автомата (упакованное состояние регистра кодера)
+ */
+typedef struct
+{
+    unsigned int state;
+}sCoder;
+
 //*****************************Функции********************************************
+/**
+ * @brief инициализация таблиц конечного автомата. Выполняется один раз при
+ *        запуске программы (при необходимости вызывается из getCodeWord);
+ *        таблицы строятся по коду ITU-T, если ранее не был выбран другой код.
+ *        Может вызываться из нескольких потоков одновременно
+ * @param
+ */
+bool initTables();
+
+/**
+ * @brief построение таблиц конечного автомата по описанию кода. Таблицы
+ *        общие для всех контекстов кодера и декодера и после построения только
+ *        читаются, поэтому функция вызывается до запуска потоков, которые
+ *        кодируют или декодируют.
+ *        Ограничения: код переключается перезаписью общих таблиц на месте без
+ *        блокировки, поэтому в процессе одновременно действует только один код,
+ *        и смена кода во время работы других потоков недопустима. Таблицы
+ *        рассчитаны только на K = SIZE+1 и N выходов без инверсии; остальные
+ *        коды (CCSDS с инверсией, K = 9 со скоростью 1/3 и т.п.) декодируются
+ *        только trellisDecode, который значительно медленнее getDecode
+ * @param
+ *  spec - описание кода (K = SIZE+1, N выходов без инверсии)
+ * @return true, если таблицы установлены; иначе установленные ранее таблицы
+ *         не изменяются
+ */
+bool initTablesFor(const sCodeSpec *spec);
+
+/**
+ * @brief построение таблиц конечного автомата по двоичному файлу решетки
+ *        (см. saveTrellis, tools/mktrellis.c)
+ * @param
+ *  filename - имя файла решетки (K = SIZE+1, N выходов без инверсии)
+ * @return true, если таблицы установлены; иначе установленные ранее таблицы
+ *         не изменяются
+ */
+bool initTablesFromFile(const char *filename);
+
+/**
+ * @brief получение таблиц из текстового файла (числа, разделенные пробельными символами)
+ * @param
+ *  filename - имя файла
+ *  table - таблица
+ *  cols - количество столбцов в таблице
+ *  rows - количество строк в таблице
+ * @return true, если прочитаны все rows*cols чисел
+ */
+bool getTable(unsigned int rows, unsigned int cols, char *filename, int table[rows][cols]);
+
 /**
  * @brief запрос закодированного слова
  * @param
@@ -29,15 +90,190 @@
 void getCodeWord(unsigned int *inputWord, unsigned int wordLen,
                  unsigned int *codeWord, unsigned int codeLen);
 
+/**
+ * @brief запрос закодированного слова с циклическим завершением (tail-biting).
+ *        Регистр заранее заполняется последними SIZE символами слова, поэтому
+ *        начальное и конечное состояния кодера совпадают и нулевой хвост не нужен:
+ *        кодовое слово имеет длину N*wordLen. Порядок подачи символов как в getCodeWord
+ * @param
+ *  inputWord - указатель на исходное слово
+ *  wordLen  - длина исходного слова
+ *  codeWord - указатель на кодированное слово
+ *  codeLen - длина кодированного слова
+ */
+void getCodeWordTailBiting(unsigned int *inputWord, unsigned int wordLen,
+                           unsigned int *codeWord, unsigned int codeLen);
+
+/**
+ * @brief запрос закодированного слова в упакованном виде (побайтовое кодирование).
+ *        Биты упакованы по 8 в байт в порядке поступления в регистр кодера,
+ *        старший бит первый. Кодовое слово дополняется SIZE-1 нулевыми символами
+ * @param
+ *  inputWord - указатель на упакованное исходное слово
+ *  wordLen - длина исходного слова в битах
+ *  codeWord - указатель на упакованное кодовое слово, не менее
+ *             (N*(wordLen + SIZE-1) + 7)/8 байт
+ */
+void getCodeWordPacked(const uint8_t *inputWord, unsigned int wordLen, uint8_t *codeWord);
+
+/**
+ * @brief запрос закодированного слова в упакованном виде с заданным порядком
+ *        битов в байте (см. getCodeWordPacked). При BIT_ORDER_LSB первым в
+ *        кодер подается младший бит байта, кодовое слово упаковывается так же
+ * @param
+ *  inputWord - указатель на упакованное исходное слово
+ *  wordLen - длина исходного слова в битах
+ *  codeWord - указатель на упакованное кодовое слово, не менее
+ *             (N*(wordLen + SIZE-1) + 7)/8 байт
+ *  order - порядок битов в байтах исходного и кодового слов
+ */
+void getCodeWordPackedOrder(const uint8_t *inputWord, unsigned int wordLen, uint8_t *codeWord,
+                            eBitOrder order);
+
+/**
+ * @brief параллельное кодирование слова. Каждая пара кодовых символов зависит
+ *        только от текущего и SIZE предыдущих входных символов, поэтому слово
+ *        разбивается на участки, которые кодируются независимо на разных
+ *        потоках; результат совпадает с getCodeWord
+ * @param
+ *  inputWord - указатель на исходное слово
+ *  wordLen  - длина исходного слова
+ *  codeWord - указатель на кодированное слово
+ *  codeLen - длина кодированного слова
+ *  threads - количество потоков (большее MAX_THREADS уменьшается до MAX_THREADS)
+ *  chunkSize - количество сдвигов регистра в одном участке
+ */
+void getCodeWordParallel(unsigned int *inputWord, unsigned int wordLen,
+                         unsigned int *codeWord, unsigned int codeLen,
+                         unsigned int threads, unsigned int chunkSize);
+
+/**
+ * @brief параллельное кодирование упакованного слова (см. getCodeWordPacked).
+ *        Результат совпадает с getCodeWordPacked
+ * @param
+ *  inputWord - указатель на упакованное исходное слово
+ *  wordLen - длина исходного слова в битах
+ *  codeWord - указатель на упакованное кодовое слово, не менее
+ *             (N*(wordLen + SIZE-1) + 7)/8 байт
+ *  threads - количество потоков (большее MAX_THREADS уменьшается до MAX_THREADS)
+ *  chunkSize - количество входных байт в одном участке
+ */
+void getCodeWordPackedParallel(const uint8_t *inputWord, unsigned int wordLen, uint8_t *codeWord,
+                               unsigned int threads, unsigned int chunkSize);
+
+/**
+ * @brief битово-параллельное (bit-sliced) кодирование 64*width независимых слов.
+ *        Бит l слова inputWord[t*width + l/64] - символ t слова с номером l.
+ *        Для каждой дорожки результат совпадает с getCodeWord
+ * @param
+ *  inputWord - указатель на входные слова, wordLen*width элементов
+ *  wordLen - длина каждого входного слова
+ *  width - количество 64-разрядных слов на один символ (1 - 64 дорожки, 4 - 256)
+ *  codeWord - указатель на кодовые слова, codeLen*width элементов
+ *  codeLen - длина каждого кодового слова
+ * @return false при нехватке памяти
+ */
+bool getCodeWordSliced(const uint64_t *inputWord, unsigned int wordLen, unsigned int width,
+                       uint64_t *codeWord, unsigned int codeLen);
+
+/**
+ * @brief перевод набора слов в битово-параллельное представление
+ * @param
+ *  words - массив указателей на слова (по одному символу 0/1 на элемент)
+ *  count - количество слов, не более 64*width
+ *  len - длина каждого слова
+ *  width - количество 64-разрядных слов на один символ
+ *  sliced - результат, len*width элементов
+ */
+void slicedPack(unsigned int **words, unsigned int count, unsigned int len,
+                unsigned int width, uint64_t *sliced);
+
+/**
+ * @brief перевод слов из битово-параллельного представления в обычное
+ * @param
+ *  sliced - слова в битово-параллельном представлении, len*width элементов
+ *  len - длина каждого слова
+ *  width - количество 64-разрядных слов на один символ
+ *  words - массив указателей на слова, куда записывается результат
+ *  count - количество слов, не более 64*width
+ */
+void slicedUnpack(const uint64_t *sliced, unsigned int len, unsigned int width,
+                  unsigned int **words, unsigned int count);
+
+/**
+ * @brief инициализация контекста потокового кодера (обнуление регистра)
+ * @param
+ *  coder - указатель на контекст кодера
+ */
+void coderInit(sCoder *coder);
+
+/**
+ * @brief кодирование очередной части потока. Символы подаются в регистр в
+ *        порядке следования в массиве, кодовые символы записываются напрямую
+ *        в буфер вызывающей стороны. Регистр не сбрасывается и хвост не дописывается
+ * @param
+ *  coder - указатель на контекст кодера
+ *  input - указатель на часть потока (по символу 0/1 на элемент)
+ *  len - количество символов
+ *  codeWord - указатель на буфер кодовых символов, не менее N*len элементов
+ * @return количество записанных кодовых символов
+ */
+unsigned int coderPush(sCoder *coder, const unsigned int *input, unsigned int len,
+                       unsigned int *codeWord);
+
+/**
+ * @brief кодирование очередной части потока в упакованном виде (побайтово).
+ *        Старший бит байта подается в регистр первым
+ * @param
+ *  coder - указатель на контекст кодера
+ *  input - указатель на упакованную часть потока
+ *  bytes - количество байт
+ *  codeWord - указатель на буфер кодовых символов, не менее N*bytes байт
+ * @return количество записанных байт
+ */
+unsigned int coderPushPacked(sCoder *coder, const uint8_t *input, unsigned int bytes,
+                             uint8_t *codeWord);
+
+/**
+ * @brief завершение потока: подача SIZE-1 нулевых символов и сброс регистра
+ * @param
+ *  coder - указатель на контекст кодера
+ *  codeWord - указатель на буфер кодовых символов, не менее N*(SIZE-1) элементов
+ * @return количество записанных кодовых символов
+ */
+unsigned int coderFlush(sCoder *coder, unsigned int *codeWord);
+
+/**
+ * @brief завершение потока в упакованном виде: N*(SIZE-1) кодовых символов,
+ *        последний байт дополняется нулями
+ * @param
+ *  coder - указатель на контекст кодера
+ *  codeWord - указатель на буфер, не менее (N*(SIZE-1) + 7)/8 байт
+ * @return количество записанных байт
+ */
+unsigned int coderFlushPacked(sCoder *coder, uint8_t *codeWord);
+
+/**
+ * @brief кодирование слова произвольным сверточным кодом, заданным решеткой.
+ *        Порядок подачи символов и длина хвоста (K-2 нулевых символа) как в getCodeWord
+ * @param
+ *  trellis - решетка кода (см. buildTrellis)
+ *  inputWord - указатель на исходное слово
+ *  wordLen  - длина исходного слова
+ *  codeWord - указатель на кодированное слово
+ *  codeLen - длина кодированного слова (outputs*(wordLen + K-2) для полного слова)
+ */
+void trellisEncode(const sTrellis *trellis, const unsigned int *inputWord, unsigned int wordLen,
+                   unsigned int *codeWord, unsigned int codeLen);
+
 /**
  * @brief запрос закодированноо символа
  * @param
- *  registerState - текущее состояние регистра кодера
- *  state - текущее состояние конечного атвомата
+ *  bit - символ, поступающий на вход кодера
+ *  state - текущее состояние конечного атвомата (упакованное состояние регистра кодера)
  *  code - массив кодовых символов
  */
-void getCodeSymbol(unsigned int registerState[SIZE], unsigned int *state,
-                   unsigned int code[N]);
+void getCodeSymbol(unsigned int bit, unsigned int *state, unsigned int code[N]);
 
 /**
  * @brief добавление в кодовый массив новых кодовых символов
@@ -0,0 +1,252 @@
+/********************************************************************************
+* @file    puncture.c
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Файл описывает реализацию пунктурирования кодовых символов. Пунктурирование
+  * позволяет повысить скорость кода 1/2 до (period)/(kept): из каждого периода
+  * шаблона передаются только отмеченные в маске кодовые символы. Перед
+  * декодированием депунктуратор восстанавливает кодовое слово, вставляя на
+  * место выколотых символов стертые символы ERASURE, которые декодер не
+  * учитывает в метриках ветвей.
+  *
+  ******************************************************************************
+*/
+
+#include "puncture.h"
+#include <string.h>
+
+/**
+ * @brief инициализация шаблона пунктурирования по строкам маски. Строка i
+ *        описывает i-й кодовый символ каждого шага: '1' - символ передается,
+ *        '0' - выкалывается (например, {"101", "110"} для DVB 3/4)
+ * @param
+ *  puncture - указатель на шаблон
+ *  rows - N строк маски одинаковой длины, не более PUNCTURE_MAX_PERIOD
+ * @return true, если маска корректна и в периоде передается хотя бы один символ
+ */
+bool punctureInit(sPuncture *puncture, const char *rows[N])
+{
+    unsigned int period = strlen(rows[0]);  //период шаблона
+    unsigned int i;                         //итератор по строкам маски
+    unsigned int t;                         //итератор по шагам периода
+    uint8_t mask[PUNCTURE_MAX_TOTAL];       //маска в порядке следования кодовых символов
+
+    if((period == 0) || (period > PUNCTURE_MAX_PERIOD))
+    {
+        return false;
+    }
+    puncture->period = period;
+    puncture->total = N*period;
+    puncture->kept = 0;
+    for(t = 0; t < period; t = t + 1)
+    {
+        for(i = 0; i < N; i = i + 1)
+        {
+            if((strlen(rows[i]) != period) || ((rows[i][t] != '0') && (rows[i][t] != '1')))
+            {
+                return false;
+            }
+            mask[N*t + i] = (rows[i][t] == '1');
+            if(mask[N*t + i])
+            {
+                puncture->keep[puncture->kept] = N*t + i;
+                puncture->kept = puncture->kept + 1;
+            }
+        }
+    }
+    if(puncture->kept == 0)
+    {
+        return false;
+    }
+
+    unsigned int phase;                     //фаза шаблона для первого бита байта
+    for(phase = 0; phase < puncture->total; phase = phase + 1)
+    {
+        unsigned int byte;                  //итератор по значениям байта
+        for(byte = 0; byte < 256; byte = byte + 1)
+        {
+            uint8_t bits = 0;               //оставшиеся биты байта
+            uint8_t count = 0;              //количество оставшихся битов
+            unsigned int k;                 //итератор по битам байта
+            for(k = 0; k < 8; k = k + 1)
+            {
+                if(mask[(phase + k) % puncture->total])
+                {
+                    bits |= ((byte >> (7 - k)) & 1) << (7 - count);
+                    count = count + 1;
+                }
+            }
+            puncture->byteBits[phase][byte] = bits;
+            puncture->byteCount[phase][byte] = count;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief инициализация стандартного шаблона пунктурирования
+ * @param
+ *  puncture - указатель на шаблон
+ *  rate - стандартный шаблон
+ * @return true при успешной инициализации
+ */
+bool punctureInitStandard(sPuncture *puncture, ePuncture rate)
+{
+    static const char *patterns[][2] =      //строки масок X и Y стандартных шаблонов
+    {
+        {"1",       "1"},                   //PUNCTURE_1_2
+        {"10",      "11"},                  //PUNCTURE_DVB_2_3
+        {"101",     "110"},                 //PUNCTURE_DVB_3_4
+        {"10101",   "11010"},               //PUNCTURE_DVB_5_6
+        {"1000101", "1111010"},             //PUNCTURE_DVB_7_8
+        {"11",      "10"},                  //PUNCTURE_80211_2_3
+        {"110",     "101"}                  //PUNCTURE_80211_3_4
+    };
+    if((unsigned int)rate >= sizeof(patterns) / sizeof(patterns[0]))
+    {
+        return false;
+    }
+    return punctureInit(puncture, patterns[rate]);
+}
+
+/**
+ * @brief количество символов, остающихся после пунктурирования кодового слова
+ * @param
+ *  puncture - указатель на шаблон
+ *  codeLen - длина кодового слова
+ */
+unsigned int punctureLength(const sPuncture *puncture, unsigned int codeLen)
+{
+    unsigned int length = (codeLen / puncture->total) * puncture->kept; //полные периоды
+    unsigned int rest = codeLen % puncture->total;                      //символы неполного периода
+    unsigned int i;
+    for(i = 0; (i < puncture->kept) && (puncture->keep[i] < rest); i = i + 1)
+    {
+        length = length + 1;
+    }
+    return length;
+}
+
+/**
+ * @brief пунктурирование кодового слова (по символу на элемент). Слово
+ *        обрабатывается периодами шаблона по таблице номеров передаваемых символов
+ * @param
+ *  puncture - указатель на шаблон
+ *  codeWord - кодовое слово
+ *  codeLen - длина кодового слова
+ *  output - пунктурированное слово, не менее punctureLength(codeLen) элементов
+ * @return длина пунктурированного слова
+ */
+unsigned int punctureWord(const sPuncture *puncture, const unsigned int *codeWord,
+                          unsigned int codeLen, unsigned int *output)
+{
+    unsigned int j = 0;                     //итератор по пунктурированному слову
+    unsigned int base;                      //начало текущего периода
+    unsigned int i;                         //итератор по передаваемым символам периода
+    for(base = 0; base + puncture->total <= codeLen; base = base + puncture->total)
+    {
+        for(i = 0; i < puncture->kept; i = i + 1)
+        {
+            output[j + i] = codeWord[base + puncture->keep[i]];
+        }
+        j = j + puncture->kept;
+    }
+    for(i = 0; (i < puncture->kept) && (base + puncture->keep[i] < codeLen); i = i + 1) //неполный последний период
+    {
+        output[j] = codeWord[base + puncture->keep[i]];
+        j = j + 1;
+    }
+    return j;
+}
+
+/**
+ * @brief пунктурирование упакованного кодового слова (старший бит первый).
+ *        Слово обрабатывается побайтово по таблицам byteBits/byteCount
+ * @param
+ *  puncture - указатель на шаблон
+ *  codeWord - упакованное кодовое слово
+ *  codeBits - длина кодового слова в битах
+ *  output - упакованное пунктурированное слово
+ * @return длина пунктурированного слова в битах
+ */
+unsigned int puncturePacked(const sPuncture *puncture, const uint8_t *codeWord,
+                            unsigned int codeBits, uint8_t *output)
+{
+    unsigned int phase = 0;                 //фаза шаблона для текущего байта
+    uint32_t acc = 0;                       //накопитель выходных битов
+    unsigned int accBits = 0;               //количество битов в накопителе
+    unsigned int pos = 0;                   //итератор по байтам выходного слова
+    unsigned int bytes = (codeBits + 7) / 8;//количество байт кодового слова
+    unsigned int i;                         //итератор по байтам кодового слова
+
+    for(i = 0; i < bytes; i = i + 1)
+    {
+        uint8_t byte = codeWord[i];
+        if((i == bytes - 1) && (codeBits % 8))  //в последнем неполном байте лишние биты обнуляются и не учитываются
+        {
+            byte &= 0xFF << (8 - codeBits % 8);
+        }
+        unsigned int count = puncture->byteCount[phase][byte];
+        acc = (acc << count) | (puncture->byteBits[phase][byte] >> (8 - count));
+        accBits = accBits + count;
+        if(accBits >= 8)
+        {
+            accBits = accBits - 8;
+            output[pos] = (acc >> accBits) & 0xFF;
+            pos = pos + 1;
+        }
+        phase = phase + 8;                  //без деления: total не меньше N
+        while(phase >= puncture->total)
+        {
+            phase = phase - puncture->total;
+        }
+    }
+
+    unsigned int length = punctureLength(puncture, codeBits);  //длина результата без битов-заполнителей последнего байта
+    if(8*pos < length)                      //запись неполного последнего байта
+    {
+        output[pos] = (acc << (8 - accBits)) & 0xFF;
+    }
+    return length;
+}
+
+/**
+ * @brief восстановление (депунктурирование) кодового слова перед декодированием:
+ *        на место выколотых символов вставляются стертые символы ERASURE
+ * @param
+ *  puncture - указатель на шаблон
+ *  input - пунктурированное слово
+ *  inputLen - длина пунктурированного слова
+ *  codeWord - восстановленное кодовое слово
+ *  codeLen - длина восстановленного кодового слова
+ * @return количество использованных символов пунктурированного слова
+ */
+unsigned int depunctureWord(const sPuncture *puncture, const unsigned int *input,
+                            unsigned int inputLen, unsigned int *codeWord, unsigned int codeLen)
+{
+    unsigned int j = 0;                     //итератор по пунктурированному слову
+    unsigned int base;                      //начало текущего периода
+    unsigned int i;                         //итератор по символам периода
+    for(i = 0; i < codeLen; i = i + 1)      //все символы изначально стерты
+    {
+        codeWord[i] = ERASURE;
+    }
+    for(base = 0; (base + puncture->total <= codeLen) && (j + puncture->kept <= inputLen);
+        base = base + puncture->total)
+    {
+        for(i = 0; i < puncture->kept; i = i + 1)
+        {
+            codeWord[base + puncture->keep[i]] = input[j + i];
+        }
+        j = j + puncture->kept;
+    }
+    for(i = 0; (i < puncture->kept) && (base + puncture->keep[i] < codeLen) && (j < inputLen); i = i + 1)
+    {
+        codeWord[base + puncture->keep[i]] = input[j];
+        j = j + 1;
+    }
+    return j;
+}
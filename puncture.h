@@ -0,0 +1,143 @@
+/********************************************************************************
+* @file    puncture.h
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Файл описывает основные переменные и методы, необходимые для пунктурирования
+  * (выкалывания) кодовых символов сверточного кодера и обратного восстановления
+  * кодового слова перед декодированием
+  *
+  ******************************************************************************
+*/
+
+#ifndef PUNCTURE
+#define PUNCTURE
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "tables.h"
+
+//*******************************Макросы******************************************
+/**
+ * @brief максимальный период шаблона пунктурирования (во входных символах)
+ */
+#define PUNCTURE_MAX_PERIOD 8
+
+/**
+ * @brief максимальное количество кодовых символов в периоде шаблона
+ */
+#define PUNCTURE_MAX_TOTAL (N*PUNCTURE_MAX_PERIOD)
+
+//*****************************Перечисления****************************************
+/**
+ * @brief стандартные шаблоны пунктурирования
+ *  PUNCTURE_1_2 - без пунктурирования
+ *  PUNCTURE_DVB_x_y - шаблоны DVB-S для скорости x/y
+ *  PUNCTURE_80211_x_y - шаблоны IEEE 802.11a для скорости x/y
+ */
+typedef enum
+{
+    PUNCTURE_1_2,
+    PUNCTURE_DVB_2_3,
+    PUNCTURE_DVB_3_4,
+    PUNCTURE_DVB_5_6,
+    PUNCTURE_DVB_7_8,
+    PUNCTURE_80211_2_3,
+    PUNCTURE_80211_3_4
+}ePuncture;
+
+//*****************************Структуры******************************************
+/**
+ * @brief структура sPuncture описывает шаблон пунктурирования и предварительно
+ *        рассчитанные по нему таблицы.
+ * Члены структуры:
+ *  period      - период шаблона во входных символах
+ *  total       - количество кодовых символов в периоде (N*period)
+ *  kept        - количество передаваемых кодовых символов в периоде
+ *  keep        - номера передаваемых кодовых символов внутри периода
+ *  byteBits    - биты, оставшиеся от байта упакованного кодового слова, в
+ *                зависимости от фазы шаблона (прижаты к старшему разряду)
+ *  byteCount   - количество битов, оставшихся от байта, в зависимости от фазы
+ */
+typedef struct
+{
+    unsigned int period;
+    unsigned int total;
+    unsigned int kept;
+    uint8_t keep[PUNCTURE_MAX_TOTAL];
+    uint8_t byteBits[PUNCTURE_MAX_TOTAL][256];
+    uint8_t byteCount[PUNCTURE_MAX_TOTAL][256];
+}sPuncture;
+
+//******************************Функции*******************************************
+/**
+ * @brief инициализация шаблона пунктурирования по строкам маски. Строка i
+ *        описывает i-й кодовый символ каждого шага: '1' - символ передается,
+ *        '0' - выкалывается (например, {"101", "110"} для DVB 3/4)
+ * @param
+ *  puncture - указатель на шаблон
+ *  rows - N строк маски одинаковой длины, не более PUNCTURE_MAX_PERIOD
+ * @return true, если маска корректна и в периоде передается хотя бы один символ
+ */
+bool punctureInit(sPuncture *puncture, const char *rows[N]);
+
+/**
+ * @brief инициализация стандартного шаблона пунктурирования
+ * @param
+ *  puncture - указатель на шаблон
+ *  rate - стандартный шаблон
+ * @return true при успешной инициализации
+ */
+bool punctureInitStandard(sPuncture *puncture, ePuncture rate);
+
+/**
+ * @brief количество символов, остающихся после пунктурирования кодового слова
+ * @param
+ *  puncture - указатель на шаблон
+ *  codeLen - длина кодового слова
+ */
+unsigned int punctureLength(const sPuncture *puncture, unsigned int codeLen);
+
+/**
+ * @brief пунктурирование кодового слова (по символу на элемент). Слово
+ *        обрабатывается периодами шаблона по таблице номеров передаваемых символов
+ * @param
+ *  puncture - указатель на шаблон
+ *  codeWord - кодовое слово
+ *  codeLen - длина кодового слова
+ *  output - пунктурированное слово, не менее punctureLength(codeLen) элементов
+ * @return длина пунктурированного слова
+ */
+unsigned int punctureWord(const sPuncture *puncture, const unsigned int *codeWord,
+                          unsigned int codeLen, unsigned int *output);
+
+/**
+ * @brief пунктурирование упакованного кодового слова (старший бит первый).
+ *        Слово обрабатывается побайтово по таблицам byteBits/byteCount
+ * @param
+ *  puncture - указатель на шаблон
+ *  codeWord - упакованное кодовое слово
+ *  codeBits - длина кодового слова в битах
+ *  output - упакованное пунктурированное слово
+ * @return длина пунктурированного слова в битах
+ */
+unsigned int puncturePacked(const sPuncture *puncture, const uint8_t *codeWord,
+                            unsigned int codeBits, uint8_t *output);
+
+/**
+ * @brief восстановление (депунктурирование) кодового слова перед декодированием:
+ *        на место выколотых символов вставляются стертые символы ERASURE
+ * @param
+ *  puncture - указатель на шаблон
+ *  input - пунктурированное слово
+ *  inputLen - длина пунктурированного слова
+ *  codeWord - восстановленное кодовое слово
+ *  codeLen - длина восстановленного кодового слова
+ * @return количество использованных символов пунктурированного слова
+ */
+unsigned int depunctureWord(const sPuncture *puncture, const unsigned int *input,
+                            unsigned int inputLen, unsigned int *codeWord, unsigned int codeLen);
+
+#endif // PUNCTURE
@@ -11,211 +11,46 @@
   ******************************************************************************
 */
 #include "tables.h"
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
-int stateTable[S][SIZE] =
-{
-    0,	0,	0,	0,	0,	0,
-    1,	0,	0,	0,	0,	0,
-    0,	1,	0,	0,	0,	0,
-    1,	1,	0,	0,	0,	0,
-    0,	0,	1,	0,	0,	0,
-    1,	0,	1,	0,	0,	0,
-    0,	1,	1,	0,	0,	0,
-    1,	1,	1,	0,	0,	0,
-    0,	0,	0,	1,	0,	0,
-    1,	0,	0,	1,	0,	0,
-    0,	1,	0,	1,	0,	0,
-    1,	1,	0,	1,	0,	0,
-    0,	0,	1,	1,	0,	0,
-    1,	0,	1,	1,	0,	0,
-    0,	1,	1,	1,	0,	0,
-    1,	1,	1,	1,	0,	0,
-    0,	0,	0,	0,	1,	0,
-    1,	0,	0,	0,	1,	0,
-    0,	1,	0,	0,	1,	0,
-    1,	1,	0,	0,	1,	0,
-    0,	0,	1,	0,	1,	0,
-    1,	0,	1,	0,	1,	0,
-    0,	1,	1,	0,	1,	0,
-    1,	1,	1,	0,	1,	0,
-    0,	0,	0,	1,	1,	0,
-    1,	0,	0,	1,	1,	0,
-    0,	1,	0,	1,	1,	0,
-    1,	1,	0,	1,	1,	0,
-    0,	0,	1,	1,	1,	0,
-    1,	0,	1,	1,	1,	0,
-    0,	1,	1,	1,	1,	0,
-    1,	1,	1,	1,	1,	0,
-    0,	0,	0,	0,	0,	1,
-    1,	0,	0,	0,	0,	1,
-    0,	1,	0,	0,	0,	1,
-    1,	1,	0,	0,	0,	1,
-    0,	0,	1,	0,	0,	1,
-    1,	0,	1,	0,	0,	1,
-    0,	1,	1,	0,	0,	1,
-    1,	1,	1,	0,	0,	1,
-    0,	0,	0,	1,	0,	1,
-    1,	0,	0,	1,	0,	1,
-    0,	1,	0,	1,	0,	1,
-    1,	1,	0,	1,	0,	1,
-    0,	0,	1,	1,	0,	1,
-    1,	0,	1,	1,	0,	1,
-    0,	1,	1,	1,	0,	1,
-    1,	1,	1,	1,	0,	1,
-    0,	0,	0,	0,	1,	1,
-    1,	0,	0,	0,	1,	1,
-    0,	1,	0,	0,	1,	1,
-    1,	1,	0,	0,	1,	1,
-    0,	0,	1,	0,	1,	1,
-    1,	0,	1,	0,	1,	1,
-    0,	1,	1,	0,	1,	1,
-    1,	1,	1,	0,	1,	1,
-    0,	0,	0,	1,	1,	1,
-    1,	0,	0,	1,	1,	1,
-    0,	1,	0,	1,	1,	1,
-    1,	1,	0,	1,	1,	1,
-    0,	0,	1,	1,	1,	1,
-    1,	0,	1,	1,	1,	1,
-    0,	1,	1,	1,	1,	1,
-    1,	1,	1,	1,	1,	1
-};
-
-uint8_t codeTable[S][N] =
-{
-    0,	0,
-    1,	1,
-    1,	0,
-    0,	1,
-    1,	1,
-    0,	0,
-    0,	1,
-    1,	0,
-    1,	1,
-    0,	0,
-    0,	1,
-    1,	0,
-    0,  0,
-    1,	1,
-    1,	0,
-    0,	1,
-    0,	0,
-    1,	1,
-    1,	0,
-    0,	1,
-    1,	1,
-    0,	0,
-    0,	1,
-    1,	0,
-    1,	1,
-    0,	0,
-    0,	1,
-    1,	0,
-    0,	0,
-    1,	1,
-    1,	0,
-    0,	1,
-    0,	1,
-    1,	0,
-    1,	1,
-    0,	0,
-    1,	0,
-    0,	1,
-    0,	0,
-    1,	1,
-    1,	0,
-    0,	1,
-    0,	0,
-    1,	1,
-    0,	1,
-    1,	0,
-    1,	1,
-    0,	0,
-    0,	1,
-    1,	0,
-    1,	1,
-    0,	0,
-    1,	0,
-    0,	1,
-    0,	0,
-    1,	1,
-    1,	0,
-    0,	1,
-    0,	0,
-    1,	1,
-    0,	1,
-    1,	0,
-    1,	1,
-    0,	0
-};
-
-int8_t jumpTable[S][S] =
-{
-         0, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 16, 17, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 18, 19, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 20, 21, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 22, 23, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 24, 25, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 26, 27, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 28, 29, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 30, 31, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 32, 33, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 34, 35, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 36, 37, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 38, 39, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 40, 41, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 42, 43, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 44, 45, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 46, 47, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 48, 49, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 50, 51, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 52, 53, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 54, 55, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 56, 57, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 58, 59, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 60, 61, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, 63,
-        1, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, 3, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, 9, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 15, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 17, 16, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 19, 18, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 21, 20, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 23, 22, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 25, 24, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 27, 26, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 29, 28, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 31, 30, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 33, 32, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 35, 34, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 37, 36, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 39, 38, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 41, 40, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 43, 42, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 45, 44, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 47, 46, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 49, 48, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 51, 50, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 53, 52, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 55, 54, -1, -1, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 57, 56, -1, -1, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 59, 58, -1, -1, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 61, 60, -1, -1,
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 63, 62
-};
+const sCodeSpec ituCode = {7, 2, {0171, 0133}, 0};
+
+const sCodeSpec ccsdsCode = {7, 2, {0171, 0133}, 1};
+
+const sCodeSpec k9Rate13Code = {9, 3, {0557, 0663, 0711}, 0};
+
+int stateTable[S][SIZE];
+
+uint8_t codeTable[S][N];
+
+int8_t jumpTable[S][S];
+
+uint8_t nextStateTable[S][2];
+
+uint8_t outputTable[S][2];
+
+uint8_t byteNextStateTable[S][256];
 
+uint16_t byteOutputTable[S][256];
+
+uint8_t bitReverseTable[256];
+
+uint8_t generatorMask[N];
+
+uint8_t prevStateTable[S][2];
+
+uint16_t branchIndexTable[2][S];
+
+uint8_t invertTable[S][1 << N];
+
+uint16_t distanceTable[S];
 
 /**
  * @brief сравнение двух целочисленных массивов
@@ -270,3 +105,436 @@ void shiftLeft(unsigned int *array, unsigned int size, unsigned int newValue)
     }
     array[0] = newValue;
 }
+
+/**
+ * @brief зеркальное отражение младших len разрядов числа
+ * @param
+ *  value - число
+ *  len - количество отражаемых разрядов
+ */
+static unsigned int reverseBits(unsigned int value, unsigned int len)
+{
+    unsigned int result = 0;
+    unsigned int k;
+    for(k = 0; k < len; k = k + 1)
+    {
+        result = (result << 1) | ((value >> k) & 1);
+    }
+    return result;
+}
+
+/**
+ * @brief размер таблиц решетки в байтах
+ * @param
+ *  states - количество состояний
+ */
+static size_t trellisTablesSize(unsigned int states)
+{
+    return (size_t)states * 2 * (2*sizeof(uint16_t) + sizeof(uint8_t));
+}
+
+/**
+ * @brief построение решетки сверточного кода по порождающим многочленам
+ * @param
+ *  trellis - указатель на строящуюся решетку (память освобождается freeTrellis)
+ *  spec - описание кода
+ * @return true, если описание корректно и память выделена
+ */
+bool buildTrellis(sTrellis *trellis, const sCodeSpec *spec)
+{
+    trellis->memory = NULL;
+    trellis->mapped = 0;
+    if((spec->K < 2) || (spec->K > MAX_K) || (spec->outputs < 1) || (spec->outputs > MAX_OUTPUTS)
+       || (spec->invert >> spec->outputs))
+    {
+        return false;
+    }
+
+    unsigned int states = 1 << (spec->K - 1);               //количество состояний
+    unsigned int masks[MAX_OUTPUTS];                        //отводы сумматоров в окне (нулевой разряд - последний символ)
+    unsigned int i;                                         //итератор по сумматорам
+    for(i = 0; i < spec->outputs; i = i + 1)
+    {
+        if(spec->generators[i] >> spec->K)                  //многочлен длиннее K разрядов
+        {
+            return false;
+        }
+        masks[i] = reverseBits(spec->generators[i], spec->K);
+    }
+
+    uint8_t *memory = malloc(trellisTablesSize(states));
+    if(!memory)
+    {
+        return false;
+    }
+    trellis->spec = *spec;
+    trellis->states = states;
+    trellis->memory = memory;
+    trellis->nextState = (uint16_t *)memory;
+    trellis->prevState = trellis->nextState + 2*states;
+    trellis->output = (uint8_t *)(trellis->prevState + 2*states);
+
+    unsigned int state;                                     //итератор по состояниям
+    for(state = 0; state < states; state = state + 1)
+    {
+        unsigned int bit;                                   //итератор по входным символам
+        for(bit = 0; bit < 2; bit = bit + 1)
+        {
+            unsigned int window = (state << 1) | bit;       //окно кодера: входной символ и регистр
+            uint8_t code = 0;                               //выходной код перехода
+            for(i = 0; i < spec->outputs; i = i + 1)
+            {
+                code = (code << 1) | __builtin_parity(window & masks[i]);
+            }
+            trellis->nextState[2*state + bit] = window & (states - 1);
+            trellis->output[2*state + bit] = code ^ spec->invert;
+            trellis->prevState[2*state + bit] = (state >> 1) | (bit * (states >> 1));  //здесь bit - старший разряд предшественника
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief освобождение памяти решетки
+ * @param
+ *  trellis - указатель на решетку
+ */
+void freeTrellis(sTrellis *trellis)
+{
+#ifndef _WIN32
+    if(trellis->mapped)                                     //таблицы размещены в отображенном файле
+    {
+        munmap(trellis->memory, trellis->mapped);
+    }
+    else
+#endif
+    {
+        free(trellis->memory);
+    }
+    trellis->memory = NULL;
+    trellis->mapped = 0;
+}
+
+/**
+ * @brief контрольная сумма FNV-1a
+ * @param
+ *  data - данные
+ *  size - размер данных в байтах
+ */
+static uint32_t checksum(const uint8_t *data, size_t size)
+{
+    uint32_t hash = 2166136261u;                            //начальное значение FNV-1a
+    size_t i;
+    for(i = 0; i < size; i = i + 1)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief запись решетки в двоичный файл (см. sTrellisFileHeader)
+ * @param
+ *  trellis - решетка кода
+ *  filename - имя файла
+ * @return true, если файл записан полностью
+ */
+bool saveTrellis(const sTrellis *trellis, const char *filename)
+{
+    sTrellisFileHeader header;                              //заголовок файла
+    size_t size = trellisTablesSize(trellis->states);       //размер таблиц
+    unsigned int i;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRELLIS_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRELLIS_FILE_VERSION;
+    header.K = trellis->spec.K;
+    header.outputs = trellis->spec.outputs;
+    for(i = 0; i < trellis->spec.outputs; i = i + 1)
+    {
+        header.generators[i] = trellis->spec.generators[i];
+    }
+    header.invert = trellis->spec.invert;
+    header.states = trellis->states;
+
+    //таблицы размещены подряд в порядке nextState, prevState, output (buildTrellis, loadTrellis)
+    header.checksum = checksum((const uint8_t *)trellis->nextState, size);
+
+    FILE *file = fopen(filename, "wb");
+    if(file == NULL)
+    {
+        return false;
+    }
+    bool written = (fwrite(&header, sizeof(header), 1, file) == 1)
+                && (fwrite(trellis->nextState, 1, size, file) == size);
+    return (fclose(file) == 0) && written;
+}
+
+/**
+ * @brief загрузка решетки из двоичного файла. Файл отображается в память
+ *        (mmap), таблицы решетки указывают прямо в отображение; проверяются
+ *        сигнатура, версия, описание кода, размер и контрольная сумма. Таблицы
+ *        не перестраиваются: проверяется лишь, что номера состояний и выходов
+ *        не выходят за границы. Таблицы загруженной решетки доступны только
+ *        для чтения
+ * @param
+ *  trellis - указатель на загружаемую решетку (память освобождается freeTrellis)
+ *  filename - имя файла
+ * @return true, если файл корректен
+ */
+bool loadTrellis(sTrellis *trellis, const char *filename)
+{
+    uint8_t *memory;                                        //содержимое файла
+    size_t fileSize;                                        //размер файла
+
+    trellis->memory = NULL;
+    trellis->mapped = 0;
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    struct stat info;
+    if(fd < 0)
+    {
+        return false;
+    }
+    if((fstat(fd, &info) != 0) || ((size_t)info.st_size < sizeof(sTrellisFileHeader)))
+    {
+        close(fd);
+        return false;
+    }
+    fileSize = info.st_size;
+    memory = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);                                              //отображение остается после закрытия файла
+    if(memory == MAP_FAILED)
+    {
+        return false;
+    }
+    trellis->mapped = fileSize;
+#else
+    FILE *file = fopen(filename, "rb");                     //без mmap файл читается в кучу целиком
+    if(file == NULL)
+    {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    memory = (fileSize >= sizeof(sTrellisFileHeader)) ? malloc(fileSize) : NULL;
+    if((memory == NULL) || (fread(memory, 1, fileSize, file) != fileSize))
+    {
+        free(memory);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+#endif
+    trellis->memory = memory;
+
+    const sTrellisFileHeader *header = (const sTrellisFileHeader *)memory;
+    bool valid = (memcmp(header->magic, TRELLIS_FILE_MAGIC, sizeof(header->magic)) == 0)
+              && (header->version == TRELLIS_FILE_VERSION)
+              && (header->K >= 2) && (header->K <= MAX_K)
+              && (header->outputs >= 1) && (header->outputs <= MAX_OUTPUTS)
+              && (header->states == (1u << (header->K - 1)))
+              && (fileSize == sizeof(sTrellisFileHeader) + trellisTablesSize(header->states));
+    if(valid)
+    {
+        valid = (checksum(memory + sizeof(sTrellisFileHeader), trellisTablesSize(header->states)) == header->checksum);
+    }
+
+    unsigned int i;
+    const uint16_t *states = (const uint16_t *)(memory + sizeof(sTrellisFileHeader));    //nextState и prevState подряд
+    const uint8_t *outputs = (const uint8_t *)(states + 4*header->states);
+    for(i = 0; valid && (i < 4*header->states); i = i + 1)  //таблицам доверяет контрольная сумма, границы
+    {                                                       //проверяются только для безопасности обращений
+        valid = (states[i] < header->states);
+    }
+    for(i = 0; valid && (i < 2*header->states); i = i + 1)
+    {
+        valid = (outputs[i] < (1u << header->outputs));
+    }
+    if(valid)
+    {
+        valid = (header->invert >> header->outputs) == 0;
+    }
+
+    sCodeSpec spec;                                         //описание кода из заголовка
+    memset(&spec, 0, sizeof(spec));
+    spec.K = header->K;
+    spec.outputs = header->outputs;
+    for(i = 0; i < MAX_OUTPUTS; i = i + 1)
+    {
+        spec.generators[i] = header->generators[i];
+    }
+    spec.invert = header->invert;
+    if(!valid)
+    {
+        freeTrellis(trellis);
+        return false;
+    }
+
+    trellis->spec = spec;
+    trellis->states = header->states;
+    trellis->nextState = (uint16_t *)(memory + sizeof(sTrellisFileHeader));   //таблицы используются на месте
+    trellis->prevState = trellis->nextState + 2*trellis->states;
+    trellis->output = (uint8_t *)(trellis->prevState + 2*trellis->states);
+    return true;
+}
+
+/**
+ * @brief заполнение таблиц конечного автомата (stateTable, codeTable, jumpTable,
+ *        nextStateTable, outputTable, prevStateTable, branchIndexTable, invertTable,
+ *        distanceTable, generatorMask) по решетке кода.
+ *        Таблицы общие для процесса и перезаписываются на месте без блокировки:
+ *        вызов допустим, только пока другие потоки не кодируют и не декодируют
+ * @param
+ *  trellis - решетка кода с K = SIZE+1, S состояниями и N выходами без инверсии
+ * @return true, если решетка подходит для таблиц конечного автомата (при
+ *         элементах таблиц вне диапазона таблицы не изменяются)
+ */
+bool setTables(const sTrellis *trellis)
+{
+    if((trellis->spec.K != SIZE + 1) || (trellis->spec.outputs != N) || trellis->spec.invert
+       || (trellis->states != S))
+    {
+        return false;
+    }
+
+    unsigned int state;                                     //итератор по состояниям
+    unsigned int i;
+    for(i = 0; i < 2*S; i = i + 1)                          //до записи в таблицы: все элементы в пределах S и 2^N
+    {
+        if((trellis->nextState[i] >= S) || (trellis->prevState[i] >= S) || (trellis->output[i] >> N))
+        {
+            return false;
+        }
+    }
+    for(i = 0; i < N; i = i + 1)
+    {
+        generatorMask[i] = reverseBits(trellis->spec.generators[i], SIZE + 1);
+    }
+    for(state = 0; state < S; state = state + 1)
+    {
+        unsigned int k;                                     //итератор по разрядам регистра
+        for(k = 0; k < SIZE; k = k + 1)
+        {
+            stateTable[state][k] = (state >> k) & 1;        //нулевой разряд - последний поступивший символ
+        }
+        for(k = 0; k < S; k = k + 1)
+        {
+            jumpTable[state][k] = -1;
+        }
+    }
+
+    for(state = 0; state < S; state = state + 1)
+    {
+        unsigned int bit;                                   //итератор по входным символам
+        for(bit = 0; bit < 2; bit = bit + 1)
+        {
+            unsigned int next = trellis->nextState[2*state + bit];
+            uint8_t code = trellis->output[2*state + bit];
+            nextStateTable[state][bit] = next;
+            outputTable[state][bit] = code;
+            prevStateTable[state][bit] = trellis->prevState[2*state + bit];
+
+            //столбец таблицы переходов: символ, вытесняемый из старшего разряда, инвертирует младший разряд
+            unsigned int column = next ^ (state >> (SIZE - 1));
+            jumpTable[state][column] = next;
+            for(i = 0; i < N; i = i + 1)
+            {
+                uint8_t symbol = (code >> (N - 1 - i)) & 1;
+                if((state >= S/2) && (codeTable[column][i] != symbol))  //столбец уже заполнен другим переходом
+                {
+                    return false;
+                }
+                codeTable[column][i] = symbol;
+            }
+        }
+    }
+
+    for(state = 0; state < S; state = state + 1)
+    {
+        unsigned int d;                                     //старший разряд предшественника
+        for(d = 0; d < 2; d = d + 1)
+        {
+            unsigned int code = outputTable[prevStateTable[state][d]][state & 1];
+            branchIndexTable[d][state] = (2*code) | ((2*code + 1) << 8);
+        }
+        memset(invertTable[state], INVERT_NONE, sizeof(invertTable[state]));
+        if(outputTable[state][0] != outputTable[state][1])  //иначе входной символ по коду не определяется
+        {
+            invertTable[state][outputTable[state][0]] = nextStateTable[state][0] << 1;
+            invertTable[state][outputTable[state][1]] = (nextStateTable[state][1] << 1) | 1;
+        }
+    }
+
+    bool changed = true;                                    //признак изменения расстояний на проходе
+    for(state = 0; state < S; state = state + 1)
+    {
+        distanceTable[state] = (state == 0) ? 0 : 0xFFFF;
+    }
+    while(changed)                                          //поиск кратчайших путей из нулевого состояния
+    {
+        changed = false;
+        for(state = 0; state < S; state = state + 1)
+        {
+            unsigned int bit;
+            for(bit = 0; (bit < 2) && (distanceTable[state] != 0xFFFF); bit = bit + 1)
+            {
+                unsigned int next = nextStateTable[state][bit];
+                unsigned int weight = 0;                    //вес выходного кода перехода
+                for(i = 0; i < N; i = i + 1)
+                {
+                    weight = weight + ((outputTable[state][bit] >> i) & 1);
+                }
+                if(distanceTable[state] + weight < distanceTable[next])
+                {
+                    distanceTable[next] = distanceTable[state] + weight;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief построение таблиц byteNextStateTable и byteOutputTable по таблицам
+ *        nextStateTable и outputTable, а также bitReverseTable. Должна
+ *        вызываться после setTables
+ * @param
+ *  нет
+ */
+void buildByteTables(void)
+{
+    unsigned int state;                                     //итератор по состояниям конечного автомата
+    for(state = 0; state < S; state = state + 1)
+    {
+        unsigned int byte;                                  //итератор по значениям входного байта
+        for(byte = 0; byte < 256; byte = byte + 1)
+        {
+            unsigned int current = state;                   //текущее состояние при подаче битов байта
+            uint16_t code = 0;                              //накопленный выходной код
+            int k;                                          //итератор по битам байта (от старшего к младшему)
+            for(k = 7; k >= 0; k = k - 1)
+            {
+                unsigned int bit = (byte >> k) & 1;
+                code = (code << N) | outputTable[current][bit];
+                current = nextStateTable[current][bit];
+            }
+            byteNextStateTable[state][byte] = current;
+            byteOutputTable[state][byte] = code;
+        }
+    }
+
+    unsigned int byte;                                      //итератор по значениям байта
+    for(byte = 0; byte < 256; byte = byte + 1)
+    {
+        uint8_t reversed = 0;                               //байт с битами в обратном порядке
+        unsigned int k;
+        for(k = 0; k < 8; k = k + 1)
+        {
+            reversed |= ((byte >> k) & 1) << (7 - k);
+        }
+        bitReverseTable[byte] = reversed;
+    }
+}
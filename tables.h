@@ -40,11 +40,154 @@
  */
 #define S 64
 
+/**
+ * @brief значение стертого символа. Стертые символы вставляются депунктуратором
+ *        на место невыданных кодовых символов и не учитываются в метриках ветвей
+ */
+#define ERASURE 2
+
+/**
+ * @brief значение таблицы обращения кода (см. invertTable) для выходного кода,
+ *        который не выдается ни по одному входному символу
+ */
+#define INVERT_NONE 0xFF
+
+/**
+ * @brief максимальная длина кодового ограничения K для кода, задаваемого порождающими
+ *        многочленами (количество состояний 2^(K-1) не превышает 2^15)
+ */
+#define MAX_K 16
+
+/**
+ * @brief максимальное количество сумматоров (выходов) кода, задаваемого
+ *        порождающими многочленами
+ */
+#define MAX_OUTPUTS 8
+
+/**
+ * @brief наибольшее количество потоков параллельного кодирования и
+ *        декодирования; большее запрошенное количество уменьшается до него
+ *        (массивы заданий потоков размещаются в стеке)
+ */
+#define MAX_THREADS 64
+
+/**
+ * @brief сигнатура файла решетки ("CVTR")
+ */
+#define TRELLIS_FILE_MAGIC "CVTR"
+
+/**
+ * @brief версия формата файла решетки. Увеличивается при любом изменении
+ *        заголовка или порядка таблиц
+ */
+#define TRELLIS_FILE_VERSION 1
+
+#if N > 2
+#error "byteOutputTable хранит 8*N кодовых символов в uint16_t, N не должно превышать 2"
+#endif
+
+//*****************************Перечисления****************************************
+/**
+ * @brief порядок символов в байте упакованного слова
+ *  BIT_ORDER_MSB - первый символ - старший бит байта
+ *  BIT_ORDER_LSB - первый символ - младший бит байта
+ */
+typedef enum
+{
+    BIT_ORDER_MSB,
+    BIT_ORDER_LSB
+}eBitOrder;
+
+//*****************************Структуры******************************************
+/**
+ * @brief структура sCodeSpec описывает сверточный код скорости 1/outputs
+ * Члены структуры:
+ *  K           - длина кодового ограничения (регистр кодера содержит K-1 символ)
+ *  outputs     - количество сумматоров по модулю 2 (выходных символов на входной символ)
+ *  generators  - порождающие многочлены в восьмеричной записи, старший из K
+ *                разрядов соответствует последнему поступившему символу
+ *                (например, 0171 и 0133 для ITU-T)
+ *  invert      - маска инвертируемых выходов (бит outputs-1-i для i-го выхода)
+ */
+typedef struct
+{
+    unsigned int K;
+    unsigned int outputs;
+    unsigned int generators[MAX_OUTPUTS];
+    unsigned int invert;
+}sCodeSpec;
+
+/**
+ * @brief структура sTrellis описывает решетку сверточного кода, построенную по sCodeSpec.
+ *        Состояние - содержимое регистра кодера, последний поступивший символ
+ *        хранится в младшем разряде: next = ((state << 1) | bit) & (states - 1)
+ * Члены структуры:
+ *  spec        - описание кода
+ *  states      - количество состояний 2^(K-1)
+ *  nextState   - таблица следующих состояний [states][2]
+ *  output      - таблица выходных кодов [states][2], первый выход - старший бит
+ *  prevState   - таблица предшественников [states][2]: из prevState[s][d]
+ *                в s ведет переход по символу s & 1
+ *  memory      - память, в которой размещены таблицы
+ *  mapped      - размер отображенного в память файла решетки (0, если
+ *                таблицы размещены в куче)
+ */
+typedef struct
+{
+    sCodeSpec spec;
+    unsigned int states;
+    uint16_t *nextState;
+    uint8_t *output;
+    uint16_t *prevState;
+    void *memory;
+    size_t mapped;
+}sTrellis;
+
+/**
+ * @brief структура sTrellisFileHeader описывает заголовок двоичного файла решетки.
+ *        За заголовком без выравнивания следуют таблицы nextState[states][2],
+ *        prevState[states][2] (uint16_t) и output[states][2] (uint8_t) в том же
+ *        виде, в каком они размещаются buildTrellis, поэтому загруженный файл
+ *        используется на месте без разбора. Числа записаны в порядке байт
+ *        машины, на которой создан файл; файл другого порядка байт отвергается
+ *        по полю version
+ * Члены структуры:
+ *  magic       - сигнатура TRELLIS_FILE_MAGIC
+ *  version     - версия формата TRELLIS_FILE_VERSION
+ *  K, outputs, generators, invert - описание кода (см. sCodeSpec)
+ *  states      - количество состояний 2^(K-1)
+ *  checksum    - контрольная сумма FNV-1a таблиц
+ *  reserved    - не используется (0)
+ */
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t K;
+    uint32_t outputs;
+    uint32_t generators[MAX_OUTPUTS];
+    uint32_t invert;
+    uint32_t states;
+    uint32_t checksum;
+    uint32_t reserved;
+}sTrellisFileHeader;
+
 //**************************Переменные*******************************************
 /**
- * @brief регистр кодирования
+ * @brief сверточный код ITU-T: K = 7, скорость 1/2, многочлены 171, 133
  */
-unsigned int coderRegister[SIZE];
+extern const sCodeSpec ituCode;
+
+/**
+ * @brief сверточный код CCSDS: K = 7, скорость 1/2, многочлены 171, 133,
+ *        второй выход инвертирован
+ */
+extern const sCodeSpec ccsdsCode;
+
+/**
+ * @brief сверточный код K = 9, скорость 1/3, многочлены 557, 663, 711
+ */
+extern const sCodeSpec k9Rate13Code;
 
 /**
  * @brief таблица состояний конечного автомата
@@ -73,6 +216,90 @@ extern uint8_t codeTable[S][N];
  */
 extern int8_t jumpTable[S][S];
 
+/**
+ * @brief таблица следующих состояний конечного автомата
+ *        nextStateTable[s][b] - состояние, в которое переходит автомат
+ *        из состояния s при поступлении на вход символа b.
+ *        Строится один раз по решетке кода (см. setTables)
+ */
+extern uint8_t nextStateTable[S][2];
+
+/**
+ * @brief таблица выходных кодов конечного автомата
+ *        outputTable[s][b] - N кодовых символов, выдаваемых кодером при
+ *        переходе из состояния s по входному символу b. Символы упакованы
+ *        в биты числа, первый кодовый символ - старший бит.
+ *        Строится один раз по решетке кода (см. setTables)
+ */
+extern uint8_t outputTable[S][2];
+
+/**
+ * @brief таблица следующих состояний при побайтовом кодировании
+ *        byteNextStateTable[s][byte] - состояние, в которое переходит автомат
+ *        из состояния s после подачи на вход 8 символов байта byte
+ *        (старший бит подается первым)
+ */
+extern uint8_t byteNextStateTable[S][256];
+
+/**
+ * @brief таблица выходных кодов при побайтовом кодировании
+ *        byteOutputTable[s][byte] - 8*N кодовых символов, выдаваемых кодером
+ *        из состояния s на байт byte. Первый кодовый символ - старший бит
+ */
+extern uint16_t byteOutputTable[S][256];
+
+/**
+ * @brief таблица обращения порядка битов байта
+ *        bitReverseTable[byte] - байт byte с битами в обратном порядке.
+ *        Переводит упакованные слова BIT_ORDER_LSB в BIT_ORDER_MSB и обратно
+ */
+extern uint8_t bitReverseTable[256];
+
+/**
+ * @brief маски отводов сумматоров по модулю 2
+ *        generatorMask[i] - отводы i-го сумматора в окне из SIZE+1 символов,
+ *        нулевой бит соответствует символу, поступившему на вход последним.
+ *        Заполняются по порождающим многочленам кода (см. setTables)
+ */
+extern uint8_t generatorMask[N];
+
+/**
+ * @brief таблица предшественников конечного автомата
+ *        prevStateTable[s][d] - состояние, из которого в s ведет переход
+ *        по символу s & 1; d - старший разряд предшественника
+ */
+extern uint8_t prevStateTable[S][2];
+
+/**
+ * @brief таблица выбора метрик ветвей для векторного декодера
+ *        branchIndexTable[d][s] - номера байтов метрики ветви, ведущей в s из
+ *        prevStateTable[s][d], в массиве 16-разрядных метрик ветвей: младший
+ *        байт 2*code, старший 2*code+1, где code - выходной код перехода
+ *        (см. outputTable). Позволяет выбирать метрики ветвей всех состояний
+ *        одной перестановкой байтов
+ */
+extern uint16_t branchIndexTable[2][S];
+
+/**
+ * @brief таблица обращения кода
+ *        invertTable[s][code] - переход, по которому кодер из состояния s выдает
+ *        упакованный выходной код code (см. outputTable): (следующее состояние << 1)
+ *        | входной символ, или INVERT_NONE, если такого перехода нет. Позволяет
+ *        восстановить исходное слово по принятому без ошибок кодовому слову за
+ *        один проход, по одному обращению к таблице на шаг
+ */
+extern uint8_t invertTable[S][1 << N];
+
+/**
+ * @brief таблица расстояний конечного автомата
+ *        distanceTable[s] - наименьший вес кодовой последовательности, которая
+ *        переводит кодер из нулевого состояния в s. Метрики путей декодера после
+ *        достаточно длинного участка без ошибок равны (с точностью до общей
+ *        постоянной) distanceTable[s ^ state], где state - состояние кодера на
+ *        участке (см. getDecodeSyndrome)
+ */
+extern uint16_t distanceTable[S];
+
 
 //*****************************Функции********************************************
 /**
@@ -102,5 +329,68 @@ void initArray(unsigned int * array, unsigned int size);
  */
 void shiftLeft(unsigned int * array, unsigned int size, unsigned int newValue);
 
+/**
+ * @brief построение решетки сверточного кода по порождающим многочленам
+ * @param
+ *  trellis - указатель на строящуюся решетку (память освобождается freeTrellis)
+ *  spec - описание кода
+ * @return true, если описание корректно и память выделена
+ */
+bool buildTrellis(sTrellis *trellis, const sCodeSpec *spec);
+
+/**
+ * @brief освобождение памяти решетки
+ * @param
+ *  trellis - указатель на решетку
+ */
+void freeTrellis(sTrellis *trellis);
+
+/**
+ * @brief запись решетки в двоичный файл (см. sTrellisFileHeader)
+ * @param
+ *  trellis - решетка кода
+ *  filename - имя файла
+ * @return true, если файл записан полностью
+ */
+bool saveTrellis(const sTrellis *trellis, const char *filename);
+
+/**
+ * @brief загрузка решетки из двоичного файла. Файл отображается в память
+ *        (mmap), таблицы решетки указывают прямо в отображение; проверяются
+ *        сигнатура, версия, описание кода, размер и контрольная сумма. Таблицы
+ *        используются без перестроения; номера состояний и выходов проверяются
+ *        на выход за границы, поэтому файл с пересчитанной суммой может задать
+ *        другой код, но не обращение за пределы таблиц. Таблицы загруженной
+ *        решетки доступны только для чтения
+ * @param
+ *  trellis - указатель на загружаемую решетку (память освобождается freeTrellis)
+ *  filename - имя файла
+ * @return true, если файл корректен
+ */
+bool loadTrellis(sTrellis *trellis, const char *filename);
+
+/**
+ * @brief заполнение таблиц конечного автомата (stateTable, codeTable, jumpTable,
+ *        nextStateTable, outputTable, prevStateTable, branchIndexTable, invertTable,
+ *        distanceTable, generatorMask)
+ *        по решетке кода.
+ *        Таблицы общие для процесса и перезаписываются на месте без блокировки:
+ *        вызов допустим, только пока другие потоки не кодируют и не декодируют
+ * @param
+ *  trellis - решетка кода с K = SIZE+1, S состояниями и N выходами без инверсии
+ * @return true, если решетка подходит для таблиц конечного автомата (при
+ *         элементах таблиц вне диапазона таблицы не изменяются)
+ */
+bool setTables(const sTrellis *trellis);
+
+/**
+ * @brief построение таблиц byteNextStateTable и byteOutputTable по таблицам
+ *        nextStateTable и outputTable, а также bitReverseTable. Должна
+ *        вызываться после setTables
+ * @param
+ *  нет
+ */
+void buildByteTables(void);
+
 #endif // TABLES
 
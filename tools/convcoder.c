@@ -0,0 +1,702 @@
+/********************************************************************************
+* @file    convcoder.c
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Утилита потокового кодирования и декодирования файлов сверточным кодом.
+  * Файл отображается в память (mmap), стандартный ввод читается порциями.
+  * Чтение, кодирование (декодирование) и запись выполняются тремя потоками,
+  * связанными кольцевыми буферами без блокировок (один производитель - один
+  * потребитель), поэтому ввод-вывод идет одновременно с вычислениями. По
+  * завершении в stderr выводится скорость каждой стадии.
+  *
+  * Кодирование: байты входа (старший бит первый) кодируются потоковым кодером
+  * с хвостом из SIZE-1 нулей, кодовые символы пунктурируются и упаковываются,
+  * последний байт дополняется нулями. Декодирование - обратное преобразование:
+  * длина исходного потока восстанавливается по длине входа, выколотые символы
+  * заменяются стертыми, символы декодируются потоковым декодером Витерби.
+  *
+  * Сборка: gcc -std=gnu99 -O2 -pthread -iquote . tools/convcoder.c coder.c viterby.c tables.c puncture.c acs.c -lm -o convcoder
+  * Запуск: convcoder encode|decode [-r 1/2|2/3|3/4|5/6|7/8] [-d глубина] [-o выход] [вход]
+  *         (без входа или с "-" - стандартный ввод, без -o - стандартный вывод)
+  *
+  ******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "coder.h"
+#include "viterby.h"
+#include "puncture.h"
+
+//*******************************Макросы******************************************
+/**
+ * @brief размер порции входа в байтах. Кратен 840 - наименьшему общему кратному
+ *        периодов шаблонов пунктурирования 1..PUNCTURE_MAX_PERIOD, поэтому
+ *        каждая полная порция кода начинается с нулевой фазы шаблона и
+ *        занимает целое число байт
+ */
+#define RING_CHUNK (840*64)
+
+/**
+ * @brief количество элементов кольцевого буфера
+ */
+#define RING_SLOTS 8
+
+/**
+ * @brief размер выходного буфера элемента: код порции с хвостом (2*RING_CHUNK + 2)
+ *        или декодированные биты порции с задержкой декодера
+ */
+#define RING_OUTPUT (N*RING_CHUNK + DECODER_MAX_DEPTH + 64)
+
+//*****************************Структуры******************************************
+/**
+ * @brief структура sChunk описывает элемент кольцевого буфера.
+ * Члены структуры:
+ *  buffer - собственный буфер элемента
+ *  data - данные элемента (buffer или участок отображенного файла)
+ *  size - размер данных в байтах
+ *  last - последний элемент потока
+ */
+typedef struct
+{
+    uint8_t *buffer;
+    const uint8_t *data;
+    size_t size;
+    bool last;
+}sChunk;
+
+/**
+ * @brief структура sRing описывает кольцевой буфер с одним производителем и
+ *        одним потребителем. Счетчики только растут; каждый изменяет одна сторона
+ * Члены структуры:
+ *  slots - элементы буфера
+ *  head - количество опубликованных элементов (изменяет производитель)
+ *  tail - количество освобожденных элементов (изменяет потребитель)
+ */
+typedef struct
+{
+    sChunk slots[RING_SLOTS];
+    size_t head;
+    size_t tail;
+}sRing;
+
+/**
+ * @brief структура sStage описывает статистику стадии конвейера.
+ * Члены структуры:
+ *  bytes - количество обработанных байт
+ *  busy - время работы без ожидания буферов, с
+ */
+typedef struct
+{
+    uint64_t bytes;
+    double busy;
+}sStage;
+
+/**
+ * @brief структура sDepuncture описывает состояние потокового депунктуратора.
+ *        Выколотые символы конца периода выдаются перед первым символом
+ *        следующего периода; недостающие стертые символы в конце потока
+ *        дописывает вызывающая сторона
+ * Члены структуры:
+ *  lead - количество выколотых символов перед каждым передаваемым символом
+ *         периода (для первого - с учетом выколотых символов конца предыдущего)
+ *  index - номер следующего передаваемого символа периода
+ *  bits - количество принятых пунктурированных символов
+ *  symbols - количество выданных кодовых символов
+ */
+typedef struct
+{
+    uint8_t lead[PUNCTURE_MAX_TOTAL];
+    unsigned int index;
+    uint64_t bits;
+    uint64_t symbols;
+}sDepuncture;
+
+//**************************Переменные*******************************************
+static sRing input;                         //порции входа: чтение -> кодер
+static sRing output;                        //порции выхода: кодер -> запись
+static sStage readStage, codeStage, writeStage;
+static int inputFd = STDIN_FILENO;
+static int outputFd = STDOUT_FILENO;
+static const uint8_t *mapped = NULL;        //отображение входного файла (NULL - чтение порциями)
+static size_t mappedSize = 0;
+static bool failed = false;                 //ошибка одной из стадий (доступ через __atomic)
+
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief выделение рабочего буфера; при нехватке памяти утилита завершается
+ *        с сообщением и ненулевым кодом
+ * @param
+ *  size - размер буфера в байтах
+ */
+static void *allocate(size_t size)
+{
+    void *buffer = malloc(size);
+    if(!buffer)
+    {
+        fprintf(stderr, "Error! Out of memory (%zu bytes)\n", size);
+        exit(1);
+    }
+    return buffer;
+}
+
+/**
+ * @brief получение свободного элемента производителем (ожидание, если буфер полон)
+ * @param
+ *  ring - кольцевой буфер
+ */
+static sChunk *ringAcquire(sRing *ring)
+{
+    while(ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == RING_SLOTS)
+    {
+        sched_yield();
+    }
+    return &ring->slots[ring->head % RING_SLOTS];
+}
+
+/**
+ * @brief публикация заполненного элемента производителем
+ * @param
+ *  ring - кольцевой буфер
+ */
+static void ringPublish(sRing *ring)
+{
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief получение очередного элемента потребителем (ожидание, если буфер пуст)
+ * @param
+ *  ring - кольцевой буфер
+ */
+static sChunk *ringPeek(sRing *ring)
+{
+    while(__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == ring->tail)
+    {
+        sched_yield();
+    }
+    return &ring->slots[ring->tail % RING_SLOTS];
+}
+
+/**
+ * @brief освобождение обработанного элемента потребителем
+ * @param
+ *  ring - кольцевой буфер
+ */
+static void ringRelease(sRing *ring)
+{
+    __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief стадия чтения: порции отображенного файла (с подкачкой страниц) или
+ *        стандартного ввода
+ */
+static void *readerThread(void *arg)
+{
+    (void)arg;
+    size_t offset = 0;                      //смещение очередной порции
+    bool last = false;
+    long page = sysconf(_SC_PAGESIZE);
+
+    while(!last)
+    {
+        sChunk *chunk = ringAcquire(&input);
+        double start = now();
+        if(mapped)
+        {
+            size_t size = (mappedSize - offset < RING_CHUNK) ? (mappedSize - offset) : RING_CHUNK;
+            volatile uint8_t touch = 0;     //подкачка страниц порции до передачи кодеру
+            size_t i;
+            for(i = 0; i < size; i = i + page)
+            {
+                touch = touch + mapped[offset + i];
+            }
+            chunk->data = mapped + offset;
+            chunk->size = size;
+            offset = offset + size;
+            last = (offset == mappedSize);
+        }
+        else
+        {
+            size_t size = 0;
+            while(size < RING_CHUNK)        //полные порции, кроме последней
+            {
+                ssize_t got = read(inputFd, chunk->buffer + size, RING_CHUNK - size);
+                if(got < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if(got <= 0)
+                {
+                    if(got < 0)
+                    {
+                        fprintf(stderr, "Error! Can't read input: %s\n", strerror(errno));
+                        __atomic_store_n(&failed, true, __ATOMIC_RELAXED);
+                    }
+                    last = true;
+                    break;
+                }
+                size = size + got;
+            }
+            chunk->data = chunk->buffer;
+            chunk->size = size;
+        }
+        chunk->last = last;
+        readStage.bytes = readStage.bytes + chunk->size;
+        readStage.busy = readStage.busy + (now() - start);
+        ringPublish(&input);
+    }
+    return NULL;
+}
+
+/**
+ * @brief стадия записи
+ */
+static void *writerThread(void *arg)
+{
+    (void)arg;
+    bool last = false;
+    while(!last)
+    {
+        sChunk *chunk = ringPeek(&output);
+        double start = now();
+        size_t done = 0;
+        while(!__atomic_load_n(&failed, __ATOMIC_RELAXED) && (done < chunk->size))
+        {
+            ssize_t put = write(outputFd, chunk->data + done, chunk->size - done);
+            if(put < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if(put <= 0)
+            {
+                fprintf(stderr, "Error! Can't write output: %s\n", strerror(errno));
+                __atomic_store_n(&failed, true, __ATOMIC_RELAXED);
+                break;
+            }
+            done = done + put;
+        }
+        last = chunk->last;
+        writeStage.bytes = writeStage.bytes + done;
+        writeStage.busy = writeStage.busy + (now() - start);
+        ringRelease(&output);
+    }
+    return NULL;
+}
+
+/**
+ * @brief стадия кодирования. Полные порции кодируются без хвоста, к коду
+ *        последней порции дописывается хвост; код каждой порции пунктурируется
+ *        с нулевой фазы шаблона (см. RING_CHUNK)
+ * @param
+ *  puncture - шаблон пунктурирования
+ *  punctured - пунктурирование включено (скорость выше 1/2)
+ */
+static void encodeStage(const sPuncture *puncture, bool punctured)
+{
+    sCoder coder;
+    uint8_t *code = allocate(RING_OUTPUT);  //код порции до пунктурирования
+    bool last = false;
+
+    coderInit(&coder);
+    while(!last)
+    {
+        sChunk *in = ringPeek(&input);
+        sChunk *out = ringAcquire(&output);
+        double start = now();
+        uint8_t *target = punctured ? code : out->buffer;
+        unsigned int bytes = coderPushPacked(&coder, in->data, in->size, target);
+        unsigned int bits = 8*bytes;        //длина кода в битах
+        last = in->last;
+        if(last)                            //хвост сразу за кодом порции, код занимает целые байты
+        {
+            coderFlushPacked(&coder, target + bytes);
+            bits = bits + N*(SIZE-1);
+        }
+        if(punctured)
+        {
+            bits = puncturePacked(puncture, code, bits, out->buffer);
+        }
+        out->data = out->buffer;
+        out->size = (bits + 7) / 8;
+        out->last = last;
+        codeStage.bytes = codeStage.bytes + in->size;
+        codeStage.busy = codeStage.busy + (now() - start);
+        ringRelease(&input);
+        ringPublish(&output);
+    }
+    free(code);
+}
+
+/**
+ * @brief количество символов пунктурированного кода (см. punctureLength)
+ *        для потоков длиннее 2^32 символов
+ * @param
+ *  puncture - шаблон пунктурирования
+ *  codeLen - длина кода
+ */
+static uint64_t puncturedLength(const sPuncture *puncture, uint64_t codeLen)
+{
+    uint64_t length = (codeLen / puncture->total) * puncture->kept;
+    unsigned int rest = codeLen % puncture->total;
+    unsigned int i;
+    for(i = 0; (i < puncture->kept) && (puncture->keep[i] < rest); i = i + 1)
+    {
+        length = length + 1;
+    }
+    return length;
+}
+
+/**
+ * @brief длина исходного потока в байтах по длине закодированного потока:
+ *        наибольшая длина, код которой помещается в bytes байт
+ * @param
+ *  puncture - шаблон пунктурирования
+ *  bytes - длина закодированного потока в байтах
+ *  exact - после выполнения: код исходного потока занимает ровно bytes байт
+ * @return длина исходного потока или -1, если вход короче кода пустого потока
+ */
+static int64_t sourceLength(const sPuncture *puncture, uint64_t bytes, bool *exact)
+{
+    uint64_t codeBits = 8*bytes * puncture->total / puncture->kept;    //оценка длины кода сверху
+    int64_t k = (codeBits > N*(SIZE-1)) ? (codeBits - N*(SIZE-1)) / (8*N) : 0;
+    while((k >= 0) && ((puncturedLength(puncture, 8*N*(uint64_t)k + N*(SIZE-1)) + 7) / 8 > bytes))
+    {
+        k = k - 1;
+    }
+    while((puncturedLength(puncture, 8*N*(uint64_t)(k + 1) + N*(SIZE-1)) + 7) / 8 <= bytes)
+    {
+        k = k + 1;
+    }
+    *exact = (k >= 0) && ((puncturedLength(puncture, 8*N*(uint64_t)k + N*(SIZE-1)) + 7) / 8 == bytes);
+    return k;
+}
+
+/**
+ * @brief инициализация депунктуратора
+ * @param
+ *  puncture - шаблон пунктурирования
+ *  state - состояние депунктуратора
+ */
+static void depunctureInit(const sPuncture *puncture, sDepuncture *state)
+{
+    unsigned int j;
+    memset(state, 0, sizeof(*state));
+    for(j = 1; j < puncture->kept; j = j + 1)
+    {
+        state->lead[j] = puncture->keep[j] - puncture->keep[j - 1] - 1;
+    }
+    state->lead[0] = puncture->keep[0] + puncture->total - 1 - puncture->keep[puncture->kept - 1];
+}
+
+/**
+ * @brief депунктурирование части потока: на место выколотых символов
+ *        вставляются стертые символы ERASURE
+ * @param
+ *  puncture - шаблон пунктурирования
+ *  state - состояние депунктуратора
+ *  bytes - упакованные символы (старший бит первый)
+ *  count - количество символов
+ *  symbols - кодовые символы
+ * @return количество записанных кодовых символов
+ */
+static unsigned int depuncture(const sPuncture *puncture, sDepuncture *state, const uint8_t *bytes,
+                               size_t count, unsigned int *symbols)
+{
+    unsigned int j = 0;                     //итератор по кодовым символам
+    size_t i;                               //итератор по пунктурированным символам
+    if(puncture->kept == puncture->total)   //без пунктурирования - распаковка
+    {
+        for(i = 0; i < count; i = i + 1)
+        {
+            symbols[i] = (bytes[i / 8] >> (7 - i % 8)) & 1;
+        }
+        j = count;
+    }
+    else
+    {
+        unsigned int index = state->index;
+        unsigned int lead = (state->bits == 0) ? puncture->keep[0] : state->lead[index];    //в начале потока нет предыдущего периода
+        for(i = 0; i < count; i = i + 1)
+        {
+            while(lead > 0)
+            {
+                symbols[j] = ERASURE;
+                j = j + 1;
+                lead = lead - 1;
+            }
+            symbols[j] = (bytes[i / 8] >> (7 - i % 8)) & 1;
+            j = j + 1;
+            index = (index + 1 == puncture->kept) ? 0 : index + 1;
+            lead = state->lead[index];
+        }
+        state->index = index;
+    }
+    state->bits = state->bits + count;
+    state->symbols = state->symbols + j;
+    return j;
+}
+
+/**
+ * @brief стадия декодирования. Последний байт каждой порции задерживается до
+ *        следующей: только в конце потока известна длина кода, а в последнем
+ *        байте есть биты-заполнители
+ * @param
+ *  puncture - шаблон пунктурирования
+ *  depth - глубина обратного прохода декодера
+ */
+static void decodeStage(const sPuncture *puncture, unsigned int depth)
+{
+    sDecoder decoder;
+    sDepuncture state;
+    unsigned int *symbols = allocate((16*RING_CHUNK + 8*PUNCTURE_MAX_TOTAL) * sizeof(unsigned int));
+    unsigned int *bits = allocate(RING_OUTPUT * 8 * sizeof(unsigned int));
+    uint8_t held = 0;                       //задержанный последний байт
+    bool holding = false;
+    uint64_t received = 0;                  //количество принятых байт
+    uint32_t acc = 0;                       //накопитель декодированных битов
+    unsigned int accBits = 0;
+    bool last = false;
+
+    decoderInit(&decoder, depth);
+    depunctureInit(puncture, &state);
+    while(!last)
+    {
+        sChunk *in = ringPeek(&input);
+        sChunk *out = ringAcquire(&output);
+        double start = now();
+        unsigned int count = 0;             //кодовых символов в порции
+        unsigned int decoded;               //декодированных символов в порции
+        uint64_t limit = UINT64_MAX;        //длина пунктурированного кода (известна в конце потока)
+        int64_t source = 0;                 //длина исходного потока в байтах
+        last = in->last;
+        received = received + in->size;
+        if(last)
+        {
+            bool exact;
+            source = sourceLength(puncture, received, &exact);
+            if(!exact)
+            {
+                fprintf(stderr, "Warning! Input length doesn't match a coded stream, %s\n",
+                        (source < 0) ? "nothing to decode" : "trailing bits ignored");
+            }
+            limit = (source < 0) ? 0 : puncturedLength(puncture, 8*N*(uint64_t)source + N*(SIZE-1));
+        }
+        if(holding && (state.bits < limit))
+        {
+            count = count + depuncture(puncture, &state, &held, (limit - state.bits < 8) ? limit - state.bits : 8,
+                                       symbols + count);
+        }
+        size_t body = (last || (in->size == 0)) ? in->size : in->size - 1;   //без задерживаемого байта
+        if(state.bits < limit)
+        {
+            uint64_t usable = (limit - state.bits < 8*(uint64_t)body) ? limit - state.bits : 8*(uint64_t)body;
+            count = count + depuncture(puncture, &state, in->data, usable, symbols + count);
+        }
+        if(!last && (in->size > 0))
+        {
+            held = in->data[in->size - 1];
+            holding = true;
+        }
+        if(last && (source >= 0))           //стертые символы после последнего переданного символа кода
+        {
+            while(state.symbols < 8*N*(uint64_t)source + N*(SIZE-1))
+            {
+                symbols[count] = ERASURE;
+                count = count + 1;
+                state.symbols = state.symbols + 1;
+            }
+        }
+        decoded = (last && (source < 0)) ? 0 : decoderPush(&decoder, symbols, count, bits);
+        if(last && (source >= 0))
+        {
+            decoded = decoded + decoderFlush(&decoder, bits + decoded);
+        }
+        unsigned int i;
+        size_t pos = 0;                     //итератор по байтам выхода
+        for(i = 0; i < decoded; i = i + 1)  //упаковка, старший бит первый
+        {
+            acc = (acc << 1) | bits[i];
+            accBits = accBits + 1;
+            if(accBits == 8)
+            {
+                out->buffer[pos] = acc & 0xFF;
+                pos = pos + 1;
+                accBits = 0;
+            }
+        }
+        out->data = out->buffer;
+        out->size = pos;
+        out->last = last;
+        codeStage.bytes = codeStage.bytes + in->size;
+        codeStage.busy = codeStage.busy + (now() - start);
+        ringRelease(&input);
+        ringPublish(&output);
+    }
+    free(symbols);
+    free(bits);
+}
+
+/**
+ * @brief вывод скорости стадии
+ * @param
+ *  name - название стадии
+ *  stage - статистика стадии
+ */
+static void printStage(const char *name, const sStage *stage)
+{
+    fprintf(stderr, "%-7s %10.3f GB in %7.3f s busy, %7.3f GB/s\n", name, stage->bytes * 1e-9, stage->busy,
+            (stage->busy > 0) ? stage->bytes * 1e-9 / stage->busy : 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *rates[] = {"1/2", "2/3", "3/4", "5/6", "7/8"};   //шаблоны DVB-S, см. ePuncture
+    sPuncture puncture;
+    ePuncture rate = PUNCTURE_1_2;
+    unsigned int depth = 0;                 //глубина обратного прохода (0 - DECODER_DEPTH)
+    const char *outputName = NULL;
+    const char *inputName = NULL;
+    bool encode;
+    int opt;
+
+    if((argc < 2) || ((strcmp(argv[1], "encode") != 0) && (strcmp(argv[1], "decode") != 0)))
+    {
+        fprintf(stderr, "Usage: %s encode|decode [-r 1/2|2/3|3/4|5/6|7/8] [-d depth] [-o output] [input]\n",
+                argv[0]);
+        return 2;
+    }
+    encode = (strcmp(argv[1], "encode") == 0);
+    optind = 2;
+    while((opt = getopt(argc, argv, "r:d:o:")) != -1)
+    {
+        unsigned int i;
+        switch(opt)
+        {
+        case 'r':
+            for(i = 0; (i < sizeof(rates) / sizeof(rates[0])) && (strcmp(optarg, rates[i]) != 0); i = i + 1)
+            {
+            }
+            if(i == sizeof(rates) / sizeof(rates[0]))
+            {
+                fprintf(stderr, "Error! Unknown rate %s\n", optarg);
+                return 2;
+            }
+            rate = (ePuncture)i;
+            break;
+        case 'd':
+            depth = strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            outputName = optarg;
+            break;
+        default:
+            return 2;
+        }
+    }
+    if(optind < argc)
+    {
+        inputName = argv[optind];
+    }
+
+    sDecoder probe;                         //проверка глубины до запуска стадий
+    if(!punctureInitStandard(&puncture, rate) || (!encode && !decoderInit(&probe, depth)))
+    {
+        fprintf(stderr, "Error! Invalid depth %u (%u..%u)\n", depth, SIZE+1, DECODER_MAX_DEPTH);
+        return 2;
+    }
+    if(inputName && (strcmp(inputName, "-") != 0))
+    {
+        struct stat st;
+        inputFd = open(inputName, O_RDONLY);
+        if((inputFd < 0) || (fstat(inputFd, &st) != 0))
+        {
+            fprintf(stderr, "Error! Can't open %s: %s\n", inputName, strerror(errno));
+            return 1;
+        }
+        if(S_ISREG(st.st_mode) && (st.st_size > 0))   //обычный файл отображается в память
+        {
+            mappedSize = st.st_size;
+            mapped = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, inputFd, 0);
+            if(mapped == MAP_FAILED)
+            {
+                mapped = NULL;
+            }
+            else
+            {
+                madvise((void *)mapped, mappedSize, MADV_SEQUENTIAL);
+            }
+        }
+    }
+    if(outputName)
+    {
+        outputFd = open(outputName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(outputFd < 0)
+        {
+            fprintf(stderr, "Error! Can't open %s: %s\n", outputName, strerror(errno));
+            return 1;
+        }
+    }
+
+    unsigned int i;
+    for(i = 0; i < RING_SLOTS; i = i + 1)
+    {
+        input.slots[i].buffer = mapped ? NULL : allocate(RING_CHUNK);
+        output.slots[i].buffer = allocate(RING_OUTPUT);
+    }
+    initTables();
+
+    pthread_t reader, writer;
+    double start = now();
+    pthread_create(&reader, NULL, readerThread, NULL);
+    pthread_create(&writer, NULL, writerThread, NULL);
+    if(encode)
+    {
+        encodeStage(&puncture, rate != PUNCTURE_1_2);
+    }
+    else
+    {
+        decodeStage(&puncture, depth);
+    }
+    pthread_join(reader, NULL);
+    pthread_join(writer, NULL);
+    double total = now() - start;
+
+    printStage("read", &readStage);
+    printStage(encode ? "encode" : "decode", &codeStage);
+    printStage("write", &writeStage);
+    fprintf(stderr, "total   %10.3f GB in, %.3f GB out, %7.3f s, %7.3f GB/s\n", readStage.bytes * 1e-9,
+            writeStage.bytes * 1e-9, total, (total > 0) ? readStage.bytes * 1e-9 / total : 0.0);
+
+    for(i = 0; i < RING_SLOTS; i = i + 1)
+    {
+        free(input.slots[i].buffer);
+        free(output.slots[i].buffer);
+    }
+    if(mapped)
+    {
+        munmap((void *)mapped, mappedSize);
+    }
+    if(outputName && (close(outputFd) != 0))
+    {
+        __atomic_store_n(&failed, true, __ATOMIC_RELAXED);
+    }
+    return __atomic_load_n(&failed, __ATOMIC_RELAXED) ? 1 : 0;
+}
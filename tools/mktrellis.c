@@ -0,0 +1,72 @@
+/********************************************************************************
+* @file    mktrellis.c
+* @author  agent
+* @version V1.0.0
+* @date    October-2026
+  ******************************************************************************
+  * @attention
+  *	Утилита записи двоичного файла решетки сверточного кода (см. saveTrellis).
+  * Решетка строится по порождающим многочленам один раз, после чего
+  * процессы декодера загружают ее loadTrellis без разбора текстовых таблиц.
+  *
+  * Сборка: gcc -std=gnu99 -O2 -iquote . tools/mktrellis.c tables.c -o mktrellis
+  * Запуск: mktrellis файл itu|ccsds|k9
+  *         mktrellis файл K инверсия g1 g2 ... (многочлены в восьмеричной записи)
+  *
+  ******************************************************************************
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "tables.h"
+
+int main(int argc, char *argv[])
+{
+    sCodeSpec spec;                         //описание кода
+    sTrellis trellis;                       //решетка кода
+
+    memset(&spec, 0, sizeof(spec));
+    if((argc == 3) && (strcmp(argv[2], "itu") == 0))
+    {
+        spec = ituCode;
+    }
+    else if((argc == 3) && (strcmp(argv[2], "ccsds") == 0))
+    {
+        spec = ccsdsCode;
+    }
+    else if((argc == 3) && (strcmp(argv[2], "k9") == 0))
+    {
+        spec = k9Rate13Code;
+    }
+    else if((argc >= 5) && (argc - 4 <= MAX_OUTPUTS))
+    {
+        int i;                              //итератор по многочленам
+        spec.K = strtoul(argv[2], NULL, 10);
+        spec.invert = strtoul(argv[3], NULL, 8);
+        spec.outputs = argc - 4;
+        for(i = 4; i < argc; i = i + 1)
+        {
+            spec.generators[i - 4] = strtoul(argv[i], NULL, 8);
+        }
+    }
+    else
+    {
+        printf("Usage: %s file itu|ccsds|k9\n", argv[0]);
+        printf("       %s file K invert g1 g2 ... (octal)\n", argv[0]);
+        return 2;
+    }
+
+    if(!buildTrellis(&trellis, &spec))
+    {
+        printf("Error! Invalid code description\n");
+        return 1;
+    }
+    bool saved = saveTrellis(&trellis, argv[1]);
+    freeTrellis(&trellis);
+    if(!saved)
+    {
+        printf("Error! Can't write file %s\n", argv[1]);
+        return 1;
+    }
+    printf("%s: K = %u, %u outputs, %u states\n", argv[1], spec.K, spec.outputs, 1u << (spec.K - 1));
+    return 0;
+}
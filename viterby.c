@@ -16,29 +16,1343 @@
   *  правдоподобным. Остальные пути отбрасываются. Чтобы алгоритм работал более эффективно,
   *  выбирается глубина поиска (т.е. ограничивается количество простраиваемых путей).
   *  Чаще всего глубина поиска берется равной 10, но при желании ее можно изменить
-  *  (см. макрос DEPTH в заголовочном файле)
+  *  (см. макрос DEPTH в заголовочном файле). Такой поиск по дереву сохранен в
+  *  getDecodeTree; getDecode выполняет полный алгоритм Витерби со сложением-
+  *  сравнением-выбором по всем состояниям на каждом шаге.
   ******************************************************************************
 */
 
 #include "viterby.h"
+#include "coder.h"
+#include "acs.h"
 #include <malloc.h>
+#include <pthread.h>
+#include <string.h>
 
 /**
- * @brief функция запускает декодирование слова по алгоритму Витерби
+ * @brief количество слов, декодированных getDecode, и слов, декодированных
+ *        обращением кода без поиска по решетке (см. getDecodeFastStats).
+ *        Изменяются атомарно, поэтому getDecode можно вызывать из разных потоков
+ */
+static uint64_t decodeFrames = 0;
+static uint64_t decodeFastHits = 0;
+
+/**
+ * @brief однократное построение таблиц метрик ветвей (см. buildSoftTables)
+ */
+static pthread_once_t softTablesOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief метрики ветвей для жестких решений: hardPairTable[3*s0 + s1][code] -
+ *        расстояние Хэмминга между символами s0, s1 (0, 1 или ERASURE) и
+ *        упакованным выходным кодом code (см. outputTable). Стертые символы
+ *        не учитываются
+ */
+static uint16_t hardPairTable[(ERASURE + 1) * (ERASURE + 1)][1 << N];
+
+/**
+ * @brief метрики ветвей для квантованных символов: quantPairTable[bits-1]
+ *        [(q0 << bits) | q1][code], где q0, q1 - символы из bits разрядов
+ *        (0 - уверенный 0, 2^bits - 1 - уверенная 1). Метрика символа -
+ *        расстояние между уровнем символа и уровнем бита кода
+ */
+static uint16_t quantPairTable[SOFT_MAX_BITS][1 << (2*SOFT_MAX_BITS)][1 << N];
+
+/**
+ * @brief метрики символа для мягких решений: llrCostTable[llr + 128][bit] -
+ *        стоимость бита bit при логарифмическом отношении правдоподобия llr
+ *        (llr > 0 - вероятнее 0): max(0, -llr) для нуля и max(0, llr) для единицы
+ */
+static uint16_t llrCostTable[256][2];
+
+#if 8 % N
+#error "упакованные кодовые слова разбираются по 8/N шагов на байт"
+#endif
+
+/**
+ * @brief метрики ветвей для упакованных жестких решений: packedBranchTable
+ *        [byte][i][code] - метрика ветви code на шаге i из 8/N шагов, символы
+ *        которых упакованы в байт byte (старший бит - первый символ). Метрики
+ *        всех шагов байта копируются одним блоком
+ */
+static uint16_t packedBranchTable[256][8 / N][1 << N];
+
+/**
+ * @brief метрика символа с уровнем level из levels уровней для бита bit
+ * @param
+ *  level - уровень символа (ERASURE для стертого символа при levels = 2)
+ *  levels - количество уровней
+ *  bit - бит кода
+ */
+static uint16_t symbolCost(unsigned int level, unsigned int levels, unsigned int bit)
+{
+    if(level >= levels)                                     //стертый символ
+    {
+        return 0;
+    }
+    return bit ? (levels - 1 - level) : level;
+}
+
+/**
+ * @brief заполнение таблицы метрик ветвей по парам уровней символов
+ * @param
+ *  table - таблица, width^N строк
+ *  width - количество значений символа в индексе таблицы
+ *  levels - количество уровней символа (значения от levels считаются стертыми)
+ */
+static void buildPairTable(uint16_t (*table)[1 << N], unsigned int width, unsigned int levels)
+{
+    unsigned int index;                                     //итератор по парам символов
+    for(index = 0; index < width * width; index = index + 1)
+    {
+        unsigned int code;                                  //итератор по выходным кодам
+        for(code = 0; code < (1 << N); code = code + 1)
+        {
+            uint16_t metric = 0;
+            unsigned int rest = index;                      //неразобранные символы, последний - младший
+            unsigned int k;                                 //итератор по символам шага с последнего
+            for(k = 0; k < N; k = k + 1)
+            {
+                metric = metric + symbolCost(rest % width, levels, (code >> k) & 1);
+                rest = rest / width;
+            }
+            table[index][code] = metric;
+        }
+    }
+}
+
+/**
+ * @brief заполнение таблиц метрик ветвей для жестких, квантованных и мягких решений
+ * @param
+ */
+static void fillSoftTables(void)
+{
+    unsigned int bits;                                      //разрядность квантованных символов
+    int llr;
+    buildPairTable(hardPairTable, ERASURE + 1, 2);
+    for(bits = 1; bits <= SOFT_MAX_BITS; bits = bits + 1)
+    {
+        buildPairTable(quantPairTable[bits - 1], 1 << bits, 1 << bits);
+    }
+    for(llr = -128; llr < 128; llr = llr + 1)
+    {
+        llrCostTable[llr + 128][0] = (llr < 0) ? -llr : 0;
+        llrCostTable[llr + 128][1] = (llr > 0) ? llr : 0;
+    }
+    unsigned int byte;                                      //итератор по значениям байта
+    for(byte = 0; byte < 256; byte = byte + 1)
+    {
+        unsigned int i;                                     //итератор по шагам байта
+        for(i = 0; i < 8 / N; i = i + 1)
+        {
+            unsigned int index = 0;                         //номер пары символов в hardPairTable
+            unsigned int k;
+            for(k = 0; k < N; k = k + 1)
+            {
+                index = index * (ERASURE + 1) + ((byte >> (7 - N*i - k)) & 1);
+            }
+            memcpy(packedBranchTable[byte][i], hardPairTable[index], sizeof(packedBranchTable[byte][i]));
+        }
+    }
+}
+
+/**
+ * @brief построение таблиц метрик ветвей при первом вызове. Вызывается из
+ *        любого потока: таблицы строятся ровно один раз
+ * @param
+ */
+static void buildSoftTables(void)
+{
+    pthread_once(&softTablesOnce, fillSoftTables);
+}
+
+/**
+ * @brief получение метрик ветвей порции шагов из принятых символов
+ * @param
+ *  codeWord - принятые символы (тип зависит от способа получения метрик)
+ *  bits - разрядность квантованных символов (для других способов не используется)
+ *  first - первый шаг порции
+ *  count - количество шагов порции
+ *  branch - метрики ветвей шагов, 2^N элементов на шаг
+ */
+typedef void (*tBranchFill)(const void *codeWord, unsigned int bits, unsigned int first,
+                            unsigned int count, uint16_t (*branch)[1 << N]);
+
+/**
+ * @brief метрики ветвей для жестких решений (символы 0, 1; остальные значения
+ *        считаются стертыми), см. tBranchFill
+ */
+static void hardFill(const void *codeWord, unsigned int bits, unsigned int first,
+                     unsigned int count, uint16_t (*branch)[1 << N])
+{
+    const unsigned int *symbols = (const unsigned int *)codeWord + N*first;
+    unsigned int i;
+    (void)bits;                                             //разрядность не используется: символы жесткие
+    for(i = 0; i < count; i = i + 1)
+    {
+        unsigned int index = 0;                             //номер пары символов в таблице
+        unsigned int k;
+        for(k = 0; k < N; k = k + 1)
+        {
+            unsigned int symbol = symbols[N*i + k];
+            index = index * (ERASURE + 1) + ((symbol < ERASURE) ? symbol : ERASURE);
+        }
+        memcpy(branch[i], hardPairTable[index], sizeof(branch[i]));
+    }
+}
+
+/**
+ * @brief метрики ветвей для квантованных символов из bits разрядов, см. tBranchFill
+ */
+static void quantFill(const void *codeWord, unsigned int bits, unsigned int first,
+                      unsigned int count, uint16_t (*branch)[1 << N])
+{
+    const uint8_t *symbols = (const uint8_t *)codeWord + N*first;
+    unsigned int mask = (1u << bits) - 1;                   //разряды символа
+    unsigned int i;
+    for(i = 0; i < count; i = i + 1)
+    {
+        unsigned int index = 0;                             //номер пары символов в таблице
+        unsigned int k;
+        for(k = 0; k < N; k = k + 1)
+        {
+            index = (index << bits) | (symbols[N*i + k] & mask);
+        }
+        memcpy(branch[i], quantPairTable[bits - 1][index], sizeof(branch[i]));
+    }
+}
+
+/**
+ * @brief метрики ветвей для мягких решений (int8 LLR), см. tBranchFill
+ */
+static void llrFill(const void *codeWord, unsigned int bits, unsigned int first,
+                    unsigned int count, uint16_t (*branch)[1 << N])
+{
+    const int8_t *llr = (const int8_t *)codeWord + N*first;
+    unsigned int i;
+    (void)bits;                                             //разрядность не используется: llr - полный байт
+    for(i = 0; i < count; i = i + 1)
+    {
+        unsigned int code;                                  //итератор по выходным кодам
+        for(code = 0; code < (1 << N); code = code + 1)
+        {
+            uint16_t metric = 0;
+            unsigned int k;
+            for(k = 0; k < N; k = k + 1)
+            {
+                metric = metric + llrCostTable[llr[N*i + k] + 128][(code >> (N - 1 - k)) & 1];
+            }
+            branch[i][code] = metric;
+        }
+    }
+}
+
+/**
+ * @brief метрики ветвей для упакованных жестких решений (см. tBranchFill).
+ *        Шаги, начинающиеся с границы байта, заполняются по 8/N из
+ *        packedBranchTable одним копированием
+ * @param
+ *  codeWord - упакованные символы
+ *  order - порядок битов в байте (eBitOrder)
+ *  first - первый шаг порции
+ *  count - количество шагов порции
+ *  branch - метрики ветвей шагов
+ */
+static void packedFill(const void *codeWord, unsigned int order, unsigned int first,
+                       unsigned int count, uint16_t (*branch)[1 << N])
+{
+    const uint8_t *bytes = codeWord;
+    unsigned int perByte = 8 / N;                           //шагов на байт
+    unsigned int i = 0;                                     //итератор по шагам порции
+    while(i < count)
+    {
+        unsigned int t = first + i;
+        uint8_t byte = bytes[t / perByte];
+        if(order == BIT_ORDER_LSB)
+        {
+            byte = bitReverseTable[byte];
+        }
+        if((t % perByte == 0) && (count - i >= perByte))    //все шаги байта
+        {
+            memcpy(branch[i], packedBranchTable[byte], sizeof(packedBranchTable[byte]));
+            i = i + perByte;
+        }
+        else
+        {
+            memcpy(branch[i], packedBranchTable[byte][t % perByte], sizeof(branch[i]));
+            i = i + 1;
+        }
+    }
+}
+
+/**
+ * @brief прямой проход декодера: метрики ветвей считаются порциями по
+ *        ACS_CHUNK шагов, после чего порция обрабатывается реализацией шагов ACS
+ * @param
+ *  codeWord - принятые символы (N символов на шаг)
+ *  fill - способ получения метрик ветвей
+ *  bits - разрядность квантованных символов
+ *  first - первый шаг прохода
+ *  steps - количество шагов
+ *  metric - метрики путей до прохода, после выполнения - после прохода
+ *  decisions - решения шагов (решения шага first - в decisions[0])
+ *  branch - метрики ветвей порции шагов, ACS_CHUNK элементов
+ */
+static void forwardWith(const void *codeWord, tBranchFill fill, unsigned int bits, unsigned int first,
+                        unsigned int steps, uint16_t metric[S], uint64_t *decisions,
+                        uint16_t (*branch)[1 << N])
+{
+    unsigned int t;                                         //первый шаг порции
+    for(t = 0; t < steps; t = t + ACS_CHUNK)
+    {
+        unsigned int count = (steps - t < ACS_CHUNK) ? (steps - t) : ACS_CHUNK;
+        fill(codeWord, bits, first + t, count, branch);
+        acsRun(metric, branch, count, decisions + t);
+    }
+}
+
+/**
+ * @brief прямой проход декодера с метриками ветвей порции на стеке (см. forwardWith)
+ */
+static void forward(const void *codeWord, tBranchFill fill, unsigned int bits, unsigned int first,
+                    unsigned int steps, uint16_t metric[S], uint64_t *decisions)
+{
+    uint16_t branch[ACS_CHUNK][1 << N];                     //метрики ветвей порции шагов
+    forwardWith(codeWord, fill, bits, first, steps, metric, decisions, branch);
+}
+
+/**
+ * @brief поиск состояния с наименьшей метрикой пути
+ * @param
+ *  metric - метрики путей
+ */
+static unsigned int bestState(const uint16_t *metric)
+{
+    unsigned int best = 0;                                  //состояние с наименьшей метрикой
+    unsigned int state;
+    for(state = 1; state < S; state = state + 1)
+    {
+        if((int16_t)(metric[state] - metric[best]) < 0)
+        {
+            best = state;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief обратный проход через один шаг
+ * @param
+ *  decisions - решения шага
+ *  state - состояние после шага
+ * @return состояние перед шагом
+ */
+static inline unsigned int tracebackStep(uint64_t decisions, unsigned int state)
+{
+    return (state >> 1) | ((unsigned int)((decisions >> state) & 1) << (SIZE - 1));
+}
+
+/**
+ * @brief обратный проход по решениям ACS. Символ, декодированный на шаге t,
+ *        равен младшему разряду состояния после шага и записывается, как и
+ *        в decode(), в позицию decodeWordSize-1-t
+ * @param
+ *  decisions - решения шагов
+ *  steps - количество шагов
+ *  state - состояние после последнего шага
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер декодированного слова
+ * @return состояние перед первым шагом
+ */
+static unsigned int traceback(const uint64_t *decisions, unsigned int steps, unsigned int state,
+                              unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    unsigned int t = steps;                                 //итератор по шагам
+    while(t > decodeWordSize)                               //шаги хвоста не выдаются
+    {
+        t = t - 1;
+        state = tracebackStep(decisions[t], state);
+    }
+    unsigned int *output = decodeWord + decodeWordSize - t; //позиция символа шага t-1
+    while(t > 0)
+    {
+        t = t - 1;
+        *output = state & 1;
+        state = tracebackStep(decisions[t], state);
+        output = output + 1;
+    }
+    return state;
+}
+
+/**
+ * @brief конечное состояние наиболее вероятного пути слова с нулевым начальным
+ *        состоянием: если слово содержит хвост из SIZE-1 нулей, выбирается
+ *        лучшее из состояний, допустимых после хвоста
+ * @param
+ *  metric - метрики путей после последнего шага
+ *  steps - количество шагов
+ *  decodeWordSize - размер выходного декодированного массива
+ */
+static unsigned int terminalState(const uint16_t *metric, unsigned int steps, unsigned int decodeWordSize)
+{
+    unsigned int tailMask = 0;                              //разряды состояния, обнуленные хвостом
+    if(steps >= decodeWordSize + SIZE - 1)
+    {
+        tailMask = (1u << (SIZE - 1)) - 1;
+    }
+    unsigned int best = S;                                  //конечное состояние наиболее вероятного пути
+    unsigned int state;
+    for(state = 0; state < S; state = state + 1)
+    {
+        if(!(state & tailMask) && ((best == S) || ((int16_t)(metric[state] - metric[best]) < 0)))
+        {
+            best = state;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief декодирование слова с нулевым начальным состоянием и хвостом из
+ *        SIZE-1 нулей в готовых буферах: память не выделяется
+ * @param
+ *  codeWord - принятые символы
+ *  fill - способ получения метрик ветвей
+ *  bits - разрядность квантованных символов
+ *  steps - количество шагов решетки, не меньше 1
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ *  decisions - решения шагов, steps элементов
+ *  branch - метрики ветвей порции шагов, ACS_CHUNK элементов
+ */
+static void decodeWith(const void *codeWord, tBranchFill fill, unsigned int bits, unsigned int steps,
+                       unsigned int *decodeWord, unsigned int decodeWordSize, uint64_t *decisions,
+                       uint16_t (*branch)[1 << N])
+{
+    uint16_t metric[S];                                     //метрики путей
+    unsigned int state;
+
+    for(state = 0; state < S; state = state + 1)            //начальное состояние - нулевое
+    {
+        metric[state] = (state == 0) ? 0 : 0x1000;
+    }
+    forwardWith(codeWord, fill, bits, 0, steps, metric, decisions, branch);
+
+    traceback(decisions, steps, terminalState(metric, steps, decodeWordSize), decodeWord, decodeWordSize);
+}
+
+/**
+ * @brief декодирование слова с нулевым начальным состоянием и хвостом из
+ *        SIZE-1 нулей (см. getDecode)
+ * @param
+ *  codeWord - принятые символы
+ *  fill - способ получения метрик ветвей
+ *  bits - разрядность квантованных символов
+ *  steps - количество шагов решетки
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти для решений шагов
+ */
+static bool decodeTerminated(const void *codeWord, tBranchFill fill, unsigned int bits, unsigned int steps,
+                             unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    initTables();                                           //построение таблиц конечного автомата при первом вызове
+    buildSoftTables();
+    if(steps == 0)
+    {
+        return true;
+    }
+    uint64_t *decisions = malloc(steps * sizeof(uint64_t)); //решения всех шагов, выделяются один раз на слово
+    if(!decisions)
+    {
+        return false;
+    }
+    uint16_t branch[ACS_CHUNK][1 << N];                     //метрики ветвей порции шагов
+    decodeWith(codeWord, fill, bits, steps, decodeWord, decodeWordSize, decisions, branch);
+    free(decisions);
+    return true;
+}
+
+/**
+ * @brief обращение кода на участке без ошибок: входные символы
+ *        восстанавливаются по таблице invertTable с повторным кодированием
+ *        каждого шага, пока пара символов шага совпадает с выходным кодом кодера
+ * @param
+ *  codeWord - принятые символы
+ *  first - первый шаг участка
+ *  steps - количество шагов решетки
+ *  state - состояние кодера перед шагом first, после выполнения - перед
+ *          первым несовпавшим шагом
+ *  decodeWord - декодированное слово (порядок как в traceback)
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return первый шаг, пара символов которого содержит стирание или не является
+ *         выходным кодом кодера (steps, если таких шагов нет)
+ */
+static unsigned int invertRun(const unsigned int *codeWord, unsigned int first, unsigned int steps,
+                              unsigned int *state, unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    unsigned int path = *state;                             //состояние кодера перед шагом
+    unsigned int t;                                         //итератор по шагам
+    for(t = first; t < steps; t = t + 1)
+    {
+        unsigned int code = 0;                              //упакованная пара символов шага
+        unsigned int erased = 0;                            //объединение символов шага
+        unsigned int k;
+        for(k = 0; k < N; k = k + 1)
+        {
+            code = (code << 1) | (codeWord[N*t + k] & 1);
+            erased |= codeWord[N*t + k];
+        }
+        unsigned int step = invertTable[path][code];        //переход шага
+        if((erased > 1) || (step == INVERT_NONE))           //стирание или пара не является выходным кодом - ошибка в канале
+        {
+            break;
+        }
+        if(t < decodeWordSize)
+        {
+            decodeWord[decodeWordSize - 1 - t] = step & 1;
+        }
+        path = step >> 1;
+    }
+    *state = path;
+    return t;
+}
+
+/**
+ * @brief декодирование слова, принятого без ошибок, обращением кода (см.
+ *        invertRun). Если каждая пара символов совпадает с выходным кодом
+ *        кодера, а хвост возвращает кодер в нулевое состояние, слово является
+ *        кодовым словом на расстоянии 0 от принятого и единственным решением
+ *        алгоритма Витерби
+ * @param
+ *  codeWord - принятые символы
+ *  steps - количество шагов решетки
+ *  decodeWord - декодированное слово (порядок как в traceback)
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return true, если слово принято без ошибок и стираний и декодировано
+ */
+static bool invertWord(const unsigned int *codeWord, unsigned int steps,
+                       unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    unsigned int state = 0;                                 //состояние кодера
+    if(invertRun(codeWord, 0, steps, &state, decodeWord, decodeWordSize) != steps)
+    {
+        return false;
+    }
+    if(steps >= decodeWordSize + SIZE - 1)                  //хвост должен вернуть кодер в нулевое состояние
+    {
+        return !(state & ((1u << (SIZE - 1)) - 1));
+    }
+    return true;
+}
+
+/**
+ * @brief функция запускает декодирование слова по алгоритму Витерби.
+ *        Для каждого шага решетки выполняется сложение-сравнение-выбор по всем
+ *        S состояниям, решения шагов сохраняются (по биту на состояние), после
+ *        чего наиболее вероятный путь восстанавливается обратным проходом.
+ *        Начальное состояние нулевое; если слово содержит хвост из SIZE-1 нулей
+ *        (см. getCodeWord), обратный проход начинается с лучшего из состояний,
+ *        допустимых после хвоста. Время декодирования - O(codeWordSize*S)
+ *        независимо от количества ошибок. Слово, принятое без ошибок,
+ *        декодируется сначала обращением кода за O(codeWordSize) (см.
+ *        invertWord); поиск по решетке выполняется только при несовпадении
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер мдекодированный массив
+ *  decodeWordSize - размер выходного декодированного массива
+ *  decodeWord - декодированное слово
+ * @return false при нехватке памяти
+ */
+bool getDecode(unsigned int *codeWord, unsigned int codeWordSize,
+               unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    __atomic_fetch_add(&decodeFrames, 1, __ATOMIC_RELAXED);
+    initTables();
+    if(invertWord(codeWord, codeWordSize / N, decodeWord, decodeWordSize))
+    {
+        __atomic_fetch_add(&decodeFastHits, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+    return decodeTerminated(codeWord, hardFill, 0, codeWordSize / N, decodeWord, decodeWordSize);
+}
+
+/**
+ * @brief статистика быстрого пути getDecode
+ * @param
+ *  frames - количество слов, декодированных getDecode (NULL - не требуется)
+ *  hits - количество слов, принятых без ошибок и декодированных обращением кода
+ *         (NULL - не требуется)
+ */
+void getDecodeFastStats(uint64_t *frames, uint64_t *hits)
+{
+    if(frames)
+    {
+        *frames = __atomic_load_n(&decodeFrames, __ATOMIC_RELAXED);
+    }
+    if(hits)
+    {
+        *hits = __atomic_load_n(&decodeFastHits, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief функция декодирует слово по мягким решениям демодулятора
+ *        (см. getDecode). Метрика символа - max(0, -llr) для нуля и max(0, llr)
+ *        для единицы; символ с llr = 0 считается стертым
+ * @param
+ *  llr - логарифмические отношения правдоподобия кодовых символов
+ *        (llr > 0 - вероятнее 0, llr < 0 - вероятнее 1)
+ *  codeWordSize - количество кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти
+ */
+bool getDecodeSoft(const int8_t *llr, unsigned int codeWordSize,
+                   unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    return decodeTerminated(llr, llrFill, 0, codeWordSize / N, decodeWord, decodeWordSize);
+}
+
+/**
+ * @brief функция декодирует слово по квантованным символам демодулятора
+ *        (см. getDecode). Метрики ветвей берутся из таблицы по паре символов;
+ *        при bits = 1 декодирование совпадает с декодированием жестких решений
+ * @param
+ *  symbols - кодовые символы из bits младших разрядов: 0 - уверенный 0,
+ *            2^bits - 1 - уверенная 1
+ *  codeWordSize - количество кодовых символов
+ *  bits - разрядность символов, от 1 до SOFT_MAX_BITS
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return true, если разрядность допустима и памяти достаточно
+ */
+bool getDecodeQuantized(const uint8_t *symbols, unsigned int codeWordSize, unsigned int bits,
+                        unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    if((bits < 1) || (bits > SOFT_MAX_BITS))
+    {
+        return false;
+    }
+    return decodeTerminated(symbols, quantFill, bits, codeWordSize / N, decodeWord, decodeWordSize);
+}
+
+/**
+ * @brief способ получения метрик ветвей по виду кодовых символов
+ * @param
+ *  options - вид кодовых символов (DECODE_HARD, DECODE_LLR, DECODE_QUANTIZED(bits))
+ *  bits - разрядность квантованных символов
+ * @return способ получения метрик ветвей или NULL, если вид неизвестен
+ */
+static tBranchFill optionsFill(unsigned int options, unsigned int *bits)
+{
+    *bits = options & 0xFF;
+    switch(options & ~0xFFu)
+    {
+    case DECODE_HARD:
+        return (*bits == 0) ? hardFill : NULL;
+    case DECODE_LLR:
+        return (*bits == 0) ? llrFill : NULL;
+    case DECODE_QUANTIZED(0):
+        return ((*bits >= 1) && (*bits <= SOFT_MAX_BITS)) ? quantFill : NULL;
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief размер части рабочей области с выравниванием DECODE_WORKSPACE_ALIGN
+ * @param
+ *  size - размер части в байтах
+ */
+static size_t workspaceAlign(size_t size)
+{
+    return (size + DECODE_WORKSPACE_ALIGN - 1) / DECODE_WORKSPACE_ALIGN * DECODE_WORKSPACE_ALIGN;
+}
+
+/**
+ * @brief размер рабочей области для getDecodeWorkspace
+ * @param
+ *  codeWordSize - количество кодовых символов
+ *  options - вид кодовых символов (DECODE_HARD, DECODE_LLR, DECODE_QUANTIZED(bits))
+ * @return размер в байтах или 0, если вид кодовых символов неизвестен
+ */
+size_t getDecodeWorkspaceSize(unsigned int codeWordSize, unsigned int options)
+{
+    unsigned int bits;
+    if(!optionsFill(options, &bits))
+    {
+        return 0;
+    }
+    return workspaceAlign(ACS_CHUNK * sizeof(uint16_t[1 << N]))
+         + workspaceAlign((size_t)(codeWordSize / N) * sizeof(uint64_t));
+}
+
+/**
+ * @brief функция декодирует слово (см. getDecode, getDecodeSoft,
+ *        getDecodeQuantized) в рабочей области вызывающей стороны: в начале
+ *        области - метрики ветвей порции шагов, за ними - решения всех шагов.
+ *        Память не выделяется, размер стека не зависит от длины слова
+ * @param
+ *  codeWord - кодовые символы вида options
+ *  codeWordSize - количество кодовых символов
+ *  options - вид кодовых символов (DECODE_HARD, DECODE_LLR, DECODE_QUANTIZED(bits))
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ *  workspace - рабочая область, выровненная на DECODE_WORKSPACE_ALIGN
+ *  workspaceSize - размер рабочей области
+ * @return false, если вид символов неизвестен, а область не выровнена или мала
+ */
+bool getDecodeWorkspace(const void *codeWord, unsigned int codeWordSize, unsigned int options,
+                        unsigned int *decodeWord, unsigned int decodeWordSize,
+                        void *workspace, size_t workspaceSize)
+{
+    unsigned int bits;                                      //разрядность квантованных символов
+    tBranchFill fill = optionsFill(options, &bits);
+    unsigned int steps = codeWordSize / N;                  //количество шагов решетки
+    if(!fill || ((uintptr_t)workspace % DECODE_WORKSPACE_ALIGN)
+       || (workspaceSize < getDecodeWorkspaceSize(codeWordSize, options)))
+    {
+        return false;
+    }
+    initTables();                                           //построение таблиц конечного автомата при первом вызове
+    buildSoftTables();
+    if(steps == 0)
+    {
+        return true;
+    }
+    if((fill == hardFill) && invertWord(codeWord, steps, decodeWord, decodeWordSize))   //слово без ошибок
+    {
+        return true;
+    }
+    uint16_t (*branch)[1 << N] = workspace;
+    uint64_t *decisions = (uint64_t *)((uint8_t *)workspace + workspaceAlign(ACS_CHUNK * sizeof(uint16_t[1 << N])));
+    decodeWith(codeWord, fill, bits, steps, decodeWord, decodeWordSize, decisions, branch);
+    return true;
+}
+
+/**
+ * @brief функция декодирует упакованное кодовое слово (см. getCodeWordPackedOrder)
+ *        и упаковывает результат с тем же порядком битов. Символы выдаются в
+ *        порядке поступления в кодер: результат совпадает с исходным словом
+ *        getCodeWordPackedOrder. Метрики ветвей берутся из таблицы по байту
+ *        кодового слова, обратный проход сразу собирает байты результата
+ * @param
+ *  codeWord - упакованное кодовое слово
+ *  codeBits - длина кодового слова в битах
+ *  decodeWord - упакованное декодированное слово, не менее (wordLen + 7)/8 байт
+ *  wordLen - длина декодированного слова в битах
+ *  order - порядок битов в байтах кодового и декодированного слов
+ * @return false при нехватке памяти (декодированное слово остается нулевым)
+ */
+bool getDecodePacked(const uint8_t *codeWord, unsigned int codeBits,
+                     uint8_t *decodeWord, unsigned int wordLen, eBitOrder order)
+{
+    unsigned int steps = codeBits / N;                      //количество шагов решетки
+    initTables();                                           //построение таблиц конечного автомата при первом вызове
+    buildSoftTables();
+    memset(decodeWord, 0, (wordLen + 7) / 8);
+    if(steps == 0)
+    {
+        return true;
+    }
+    uint64_t *decisions = malloc(steps * sizeof(uint64_t)); //решения всех шагов
+    if(!decisions)
+    {
+        return false;
+    }
+    uint16_t metric[S];                                     //метрики путей
+    unsigned int state;
+
+    for(state = 0; state < S; state = state + 1)            //начальное состояние - нулевое
+    {
+        metric[state] = (state == 0) ? 0 : 0x1000;
+    }
+    forward(codeWord, packedFill, order, 0, steps, metric, decisions);
+
+    state = terminalState(metric, steps, wordLen);
+    unsigned int t = steps;                                 //итератор по шагам
+    while(t > wordLen)                                      //шаги хвоста не выдаются
+    {
+        t = t - 1;
+        state = tracebackStep(decisions[t], state);
+    }
+    uint8_t byte = 0;                                       //собираемый байт результата (старший бит первый)
+    while(t > 0)
+    {
+        t = t - 1;
+        byte |= (state & 1) << (7 - t % 8);
+        if(t % 8 == 0)                                      //байт собран
+        {
+            decodeWord[t / 8] = (order == BIT_ORDER_LSB) ? bitReverseTable[byte] : byte;
+            byte = 0;
+        }
+        state = tracebackStep(decisions[t], state);
+    }
+    free(decisions);
+    return true;
+}
+
+/**
+ * @brief задание параллельного декодирования (см. getDecodeParallel)
+ * Члены структуры:
+ *  codeWord    - массив кодовых символов
+ *  steps       - количество шагов решетки
+ *  decodeWord  - декодированное слово
+ *  decodeWordSize - размер декодированного слова
+ *  segmentSize - количество шагов участка, символы которых выдаются
+ *  overlap     - количество шагов перекрытия до и после участка
+ *  decisions   - решения шагов окна участка (segmentSize + 2*overlap шагов)
+ *  first       - первый участок потока
+ *  step        - шаг по участкам
+ */
+typedef struct
+{
+    const unsigned int *codeWord;
+    unsigned int steps;
+    unsigned int *decodeWord;
+    unsigned int decodeWordSize;
+    unsigned int segmentSize;
+    unsigned int overlap;
+    uint64_t *decisions;
+    unsigned int first;
+    unsigned int step;
+}sDecodeJob;
+
+/**
+ * @brief поток параллельного декодирования. Окно участка расширяется на overlap
+ *        шагов в обе стороны: в начале окна метрики всех состояний равны и за
+ *        время перекрытия сходятся к метрикам полного прохода, а обратный проход
+ *        от конца окна за время перекрытия сходится к пути полного прохода.
+ *        Символы перекрытий не выдаются. Окно первого участка начинается с
+ *        нулевого состояния, окно последнего заканчивается хвостом, как в getDecode
+ * @param
+ *  arg - указатель на задание sDecodeJob
+ */
+static void *decodeWorker(void *arg)
+{
+    sDecodeJob *job = arg;
+    unsigned int output = (job->steps < job->decodeWordSize) ? job->steps : job->decodeWordSize;    //шаги, символы которых выдаются
+    unsigned int segment;                                   //итератор по участкам
+    for(segment = job->first; segment*job->segmentSize < output; segment = segment + job->step)
+    {
+        unsigned int begin = segment*job->segmentSize;      //первый шаг участка
+        unsigned int end = begin + job->segmentSize;        //шаг, следующий за участком
+        if(end > output)
+        {
+            end = output;
+        }
+        unsigned int head = (begin > job->overlap) ? (begin - job->overlap) : 0;   //первый шаг окна
+        unsigned int tail = end + job->overlap;             //шаг, следующий за окном
+        if(tail > job->steps)
+        {
+            tail = job->steps;
+        }
+
+        uint16_t metric[S];                                 //метрики путей
+        unsigned int state;
+        for(state = 0; state < S; state = state + 1)
+        {
+            metric[state] = ((head > 0) || (state == 0)) ? 0 : 0x1000;
+        }
+        forward(job->codeWord, hardFill, 0, head, tail - head, metric, job->decisions);
+
+        state = (tail == job->steps) ? terminalState(metric, job->steps, job->decodeWordSize) : bestState(metric);
+        unsigned int t;                                     //итератор по шагам перекрытия после участка
+        for(t = tail; t > end; t = t - 1)
+        {
+            state = tracebackStep(job->decisions[t - 1 - head], state);
+        }
+        traceback(job->decisions + (begin - head), end - begin, state,
+                  job->decodeWord, job->decodeWordSize - begin);
+    }
+    return NULL;
+}
+
+/**
+ * @brief функция декодирует длинное слово на нескольких потоках (см. getDecode).
+ *        Шаги решетки разбиваются на участки по segmentSize шагов; каждый участок
+ *        декодируется независимо в окне, расширенном на overlap шагов с обеих
+ *        сторон, и его символы записываются на свои места в decodeWord. При
+ *        перекрытии от DECODER_DEPTH шагов доля ошибок совпадает с getDecode
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ *  threads - количество потоков (большее MAX_THREADS уменьшается до MAX_THREADS)
+ *  segmentSize - количество шагов в участке (0 - поровну между потоками)
+ *  overlap - количество шагов перекрытия
+ * @return false при нехватке памяти
+ */
+bool getDecodeParallel(unsigned int *codeWord, unsigned int codeWordSize,
+                       unsigned int *decodeWord, unsigned int decodeWordSize,
+                       unsigned int threads, unsigned int segmentSize, unsigned int overlap)
+{
+    initTables();                                           //таблицы строятся до запуска потоков
+    buildSoftTables();
+    sDecodeJob job;
+    job.codeWord = codeWord;
+    job.steps = codeWordSize / N;
+    job.decodeWord = decodeWord;
+    job.decodeWordSize = decodeWordSize;
+    job.overlap = overlap;
+    unsigned int output = (job.steps < decodeWordSize) ? job.steps : decodeWordSize;    //шаги, символы которых выдаются
+    if(threads == 0)
+    {
+        threads = 1;
+    }
+    if(threads > MAX_THREADS)                               //участки распределяются по кругу и не теряются
+    {
+        threads = MAX_THREADS;
+    }
+    job.segmentSize = (segmentSize > 0) ? segmentSize : (output + threads - 1) / threads;
+    if(job.segmentSize == 0)
+    {
+        return true;
+    }
+    unsigned int segments = (output + job.segmentSize - 1) / job.segmentSize;
+    if(threads > segments)
+    {
+        threads = segments;
+    }
+
+    unsigned int window = job.segmentSize + 2*overlap;      //наибольшее количество шагов окна
+    uint64_t *decisions = malloc((size_t)threads * window * sizeof(uint64_t));
+    if(!decisions)                                          //при нехватке памяти - последовательное декодирование
+    {
+        return getDecode(codeWord, codeWordSize, decodeWord, decodeWordSize);
+    }
+
+    pthread_t tid[MAX_THREADS];                             //идентификаторы потоков
+    bool started[MAX_THREADS];                              //флаги успешного создания потоков
+    sDecodeJob jobs[MAX_THREADS];                           //задания потоков
+    unsigned int t;                                         //итератор по потокам
+    for(t = 0; t < threads; t = t + 1)
+    {
+        jobs[t] = job;
+        jobs[t].decisions = decisions + (size_t)t*window;
+        jobs[t].first = t;
+        jobs[t].step = threads;
+        started[t] = (t > 0) && !pthread_create(&tid[t], NULL, decodeWorker, &jobs[t]);    //нулевое задание выполняется в вызывающем потоке
+    }
+    for(t = 0; t < threads; t = t + 1)
+    {
+        if(started[t])
+        {
+            pthread_join(tid[t], NULL);
+        }
+        else
+        {
+            decodeWorker(&jobs[t]);                         //задание, для которого не удалось создать поток, выполняется на месте
+        }
+    }
+    free(decisions);
+    return true;
+}
+
+/**
+ * @brief метрики ветвей группы кадров для пакетной реализации шагов ACS
+ *        (символы как в hardFill). Элементы кадров, которых нет в группе,
+ *        получают нулевые метрики
+ * @param
+ *  codeWords - кодовые слова кадров группы
+ *  lanes - количество кадров в группе
+ *  first - первый шаг
+ *  count - количество шагов
+ *  branch - метрики ветвей шагов: branch[t][code][lane]
+ */
+static void batchFill(unsigned int *const codeWords[], unsigned int lanes, unsigned int first,
+                      unsigned int count, uint16_t (*branch)[1 << N][ACS_LANES])
+{
+    unsigned int i, lane, code;
+    for(i = 0; i < count; i = i + 1)
+    {
+        for(lane = 0; lane < ACS_LANES; lane = lane + 1)
+        {
+            const uint16_t *metric = hardPairTable[(ERASURE + 1) * (ERASURE + 1) - 1];  //стертые символы для отсутствующих кадров
+            if(lane < lanes)
+            {
+                const unsigned int *symbols = codeWords[lane] + N*(first + i);
+                unsigned int index = 0;                     //номер пары символов в таблице
+                unsigned int k;
+                for(k = 0; k < N; k = k + 1)
+                {
+                    index = index * (ERASURE + 1) + ((symbols[k] < ERASURE) ? symbols[k] : ERASURE);
+                }
+                metric = hardPairTable[index];
+            }
+            for(code = 0; code < (1 << N); code = code + 1)
+            {
+                branch[i][code][lane] = metric[code];
+            }
+        }
+    }
+}
+
+/**
+ * @brief функция декодирует count кадров одинаковой длины (см. getDecode).
+ *        Кадры обрабатываются группами по ACS_LANES: каждый кадр группы
+ *        занимает свой элемент вектора, и все кадры группы одновременно проходят
+ *        метрики ветвей, шаги ACS и обратный проход. Неполная группа меньше
+ *        3/4 ACS_LANES кадров декодируется по одному кадру: время шага группы
+ *        не зависит от числа занятых элементов. Память под группы выделяется,
+ *        только если есть хотя бы одна группа. Результат для каждого кадра
+ *        совпадает с getDecode
+ * @param
+ *  codeWords - кодовые слова кадров
+ *  count - количество кадров
+ *  codeWordSize - размер кодового слова кадра
+ *  decodeWords - декодированные слова кадров
+ *  decodeWordSize - размер декодированного слова кадра
+ * @return false при нехватке памяти
+ */
+bool getDecodeBatch(unsigned int *const codeWords[], unsigned int count, unsigned int codeWordSize,
+                    unsigned int *const decodeWords[], unsigned int decodeWordSize)
+{
+    initTables();                                           //построение таблиц конечного автомата при первом вызове
+    buildSoftTables();
+    unsigned int steps = codeWordSize / N;                  //количество шагов решетки
+    if((steps == 0) || (count == 0))
+    {
+        return true;
+    }
+    bool ok = true;                                         //все кадры декодированы
+    unsigned int tail = count % ACS_LANES;                  //кадры неполной последней группы
+    unsigned int batched = count - ((tail < 3*ACS_LANES/4) ? tail : 0);    //кадры, декодируемые группами
+    unsigned int f;
+    for(f = batched; f < count; f = f + 1)                  //малую группу быстрее декодировать по одному кадру
+    {
+        ok = getDecode(codeWords[f], codeWordSize, decodeWords[f], decodeWordSize) && ok;
+    }
+    if(batched == 0)
+    {
+        return ok;
+    }
+
+    unsigned int chunk = (steps < ACS_CHUNK) ? steps : ACS_CHUNK;   //шагов в порции метрик ветвей
+    uint32_t (*decisions)[S] = malloc(steps * sizeof(decisions[0]));  //решения шагов группы
+    uint16_t (*branch)[1 << N][ACS_LANES] = malloc(chunk * sizeof(branch[0]));
+    if(!decisions || !branch)                               //при нехватке памяти кадры декодируются по одному
+    {
+        free(decisions);
+        free(branch);
+        for(f = 0; f < batched; f = f + 1)
+        {
+            ok = getDecode(codeWords[f], codeWordSize, decodeWords[f], decodeWordSize) && ok;
+        }
+        return ok;
+    }
+
+    unsigned int group;                                     //первый кадр группы
+    for(group = 0; group < batched; group = group + ACS_LANES)
+    {
+        unsigned int lanes = (batched - group < ACS_LANES) ? (batched - group) : ACS_LANES;
+        uint16_t metric[S][ACS_LANES];                      //метрики путей кадров группы
+        unsigned int state[ACS_LANES];                      //текущие состояния обратного прохода
+        unsigned int s, lane, t;
+        for(s = 0; s < S; s = s + 1)                        //начальное состояние - нулевое
+        {
+            for(lane = 0; lane < ACS_LANES; lane = lane + 1)
+            {
+                metric[s][lane] = (s == 0) ? 0 : 0x1000;
+            }
+        }
+        for(t = 0; t < steps; t = t + chunk)
+        {
+            unsigned int part = (steps - t < chunk) ? (steps - t) : chunk;
+            batchFill(codeWords + group, lanes, t, part, branch);
+            acsBatchRun(metric, branch, part, decisions + t);
+        }
+
+        unsigned int tailMask = 0;                          //разряды состояния, обнуленные хвостом (см. terminalState)
+        if(steps >= decodeWordSize + SIZE - 1)
+        {
+            tailMask = (1u << (SIZE - 1)) - 1;
+        }
+        for(lane = 0; lane < ACS_LANES; lane = lane + 1)
+        {
+            state[lane] = 0;
+        }
+        for(s = 1; s < S; s = s + 1)                        //лучшее допустимое состояние каждого кадра
+        {
+            if(!(s & tailMask))
+            {
+                for(lane = 0; lane < ACS_LANES; lane = lane + 1)
+                {
+                    state[lane] = ((int16_t)(metric[s][lane] - metric[state[lane]][lane]) < 0) ? s : state[lane];
+                }
+            }
+        }
+
+        unsigned int *output[ACS_LANES];                    //декодированные слова кадров группы
+        for(lane = 0; lane < lanes; lane = lane + 1)
+        {
+            output[lane] = decodeWords[group + lane] + decodeWordSize;
+        }
+        for(t = steps; t > 0; t = t - 1)                    //обратный проход всех кадров группы по шагам
+        {
+            const uint32_t *stepDecisions = decisions[t - 1];
+            if(t <= decodeWordSize)
+            {
+                for(lane = 0; lane < lanes; lane = lane + 1)
+                {
+                    output[lane][-(int)t] = state[lane] & 1;
+                }
+            }
+            for(lane = 0; lane < lanes; lane = lane + 1)
+            {
+                state[lane] = (state[lane] >> 1) | (((stepDecisions[state[lane]] >> lane) & 1u) << (SIZE - 1));
+            }
+        }
+    }
+    free(decisions);
+    free(branch);
+    return ok;
+}
+
+/**
+ * @brief участок слова, декодируемого getDecodeSyndrome
+ * Члены структуры:
+ *  begin - первый шаг участка
+ *  end   - шаг, следующий за последним шагом участка
+ *  clean - участок без ошибок: решения шагов не сохранены, символы получены
+ *          обращением кода
+ *  first - состояние кодера в начале участка без ошибок
+ *  last  - состояние кодера в конце участка без ошибок
+ */
+typedef struct
+{
+    unsigned int begin;
+    unsigned int end;
+    bool clean;
+    uint8_t first;
+    uint8_t last;
+}sSyndromeSegment;
+
+/**
+ * @brief добавление участка в список участков слова
+ * @param
+ *  segments - список участков (расширяется при необходимости)
+ *  used - количество участков в списке
+ *  capacity - емкость списка
+ *  segment - добавляемый участок
+ * @return false при нехватке памяти
+ */
+static bool appendSegment(sSyndromeSegment **segments, unsigned int *used, unsigned int *capacity,
+                          sSyndromeSegment segment)
+{
+    if(*used >= *capacity)
+    {
+        unsigned int grown = *capacity ? 2*(*capacity) : 64;
+        sSyndromeSegment *moved = realloc(*segments, grown * sizeof(sSyndromeSegment));
+        if(!moved)
+        {
+            return false;
+        }
+        *segments = moved;
+        *capacity = grown;
+    }
+    (*segments)[*used] = segment;
+    *used = *used + 1;
+    return true;
+}
+
+/**
+ * @brief проверка метрик путей: равны ли они метрикам после участка без ошибок,
+ *        пройденного кодером в состоянии best (см. distanceTable)
+ * @param
+ *  metric - метрики путей
+ *  best - состояние с наименьшей метрикой
+ */
+static bool cleanMetrics(const uint16_t *metric, unsigned int best)
+{
+    unsigned int differ = 0;                                //объединение расхождений
+    unsigned int state;
+    for(state = 0; state < S; state = state + 1)
+    {
+        differ |= (uint16_t)(metric[state] - metric[best]) ^ distanceTable[state ^ best];
+    }
+    return differ == 0;
+}
+
+/**
+ * @brief функция декодирует слово с пропуском шагов ACS на участках без ошибок
+ *        (см. getDecode). Результат совпадает с getDecode.
+ *        Пока пары принятых символов совпадают с выходными кодами кодера на
+ *        восстановленном обращением кода пути (синдром равен нулю), метрики
+ *        путей сохраняют вид metric[s] = c + distanceTable[s ^ state]: код
+ *        линейный, и каждый шаг ACS лишь переносит этот вид на следующее
+ *        состояние пути. Поэтому шаги ACS выполняются только от первого
+ *        ненулевого синдрома до возврата метрик к этому виду (первая проверка -
+ *        через SYNDROME_CHECK шагов, далее период удваивается до ACS_CHUNK,
+ *        чтобы частые ошибки не дробили проход), а на участках между ними символы
+ *        выдаются обращением кода. Обратный проход идет по пути участка без
+ *        ошибок, если приходит в его конечное состояние; иначе решения участка
+ *        восстанавливаются шагами ACS от известных метрик его начала.
+ *        Время декодирования растет с количеством ошибок, а не с длиной слова.
+ *        Слово без ошибок декодируется обращением кода, как в getDecode; если
+ *        после SYNDROME_DENSE шагов шаги ACS заняли больше половины пути,
+ *        слово декодируется полным проходом
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти
+ */
+bool getDecodeSyndrome(unsigned int *codeWord, unsigned int codeWordSize,
+                       unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    unsigned int steps = codeWordSize / N;                  //количество шагов решетки
+    initTables();
+    buildSoftTables();
+    if(steps == 0)
+    {
+        return true;
+    }
+    if(invertWord(codeWord, steps, decodeWord, decodeWordSize))    //слово без ошибок - как в getDecode
+    {
+        return true;
+    }
+    uint64_t *decisions = malloc(steps * sizeof(uint64_t)); //решения шагов ACS (на участках без ошибок не заполняются)
+    sSyndromeSegment *segments = NULL;                      //участки слова
+    unsigned int used = 0, capacity = 0;
+    uint16_t metric[S];                                     //метрики путей
+    unsigned int state;
+    unsigned int t = 0;                                     //текущий шаг
+    unsigned int begin = 0;                                 //начало текущего участка
+    bool clean = false;                                     //текущий участок без ошибок
+    unsigned int first = 0, path = 0;                       //состояния кодера в начале участка без ошибок и на шаге t
+    uint16_t base = 0;                                      //метрика пути участка без ошибок
+    unsigned int check = SYNDROME_CHECK;                    //шаги ACS до следующей проверки метрик
+    unsigned int acs = 0;                                   //количество выполненных шагов ACS
+    bool dense = false;                                     //ошибки часты - полный проход выгоднее
+    bool ok = (decisions != NULL);
+
+    for(state = 0; state < S; state = state + 1)            //начальное состояние - нулевое
+    {
+        metric[state] = (state == 0) ? 0 : 0x1000;
+    }
+    while(ok && !dense && (t < steps))
+    {
+        if(!clean)                                          //шаги ACS до возврата метрик к виду участка без ошибок
+        {
+            unsigned int count = (steps - t < check) ? (steps - t) : check;
+            forward(codeWord, hardFill, 0, t, count, metric, decisions + t);
+            t = t + count;
+            acs = acs + count;
+            dense = (t >= SYNDROME_DENSE) && (2*acs > t);
+            unsigned int best = bestState(metric);
+            check = (2*check < ACS_CHUNK) ? (2*check) : ACS_CHUNK;
+            if(cleanMetrics(metric, best))
+            {
+                ok = appendSegment(&segments, &used, &capacity, (sSyndromeSegment){begin, t, false, 0, 0});
+                begin = t;
+                clean = true;
+                first = path = best;
+                base = metric[best];
+            }
+        }
+        else                                                //обращение кода до первого ненулевого синдрома
+        {
+            t = invertRun(codeWord, t, steps, &path, decodeWord, decodeWordSize);
+            ok = appendSegment(&segments, &used, &capacity, (sSyndromeSegment){begin, t, true, first, path});
+            for(state = 0; state < S; state = state + 1)
+            {
+                metric[state] = base + distanceTable[state ^ path];
+            }
+            begin = t;
+            clean = false;
+            check = SYNDROME_CHECK;
+        }
+    }
+    if(ok && !dense && (begin < t))
+    {
+        ok = appendSegment(&segments, &used, &capacity, (sSyndromeSegment){begin, t, false, 0, 0});
+    }
+
+    if(ok && !dense)                                        //обратный проход по участкам от конца слова
+    {
+        unsigned int i;
+        state = terminalState(metric, steps, decodeWordSize);
+        for(i = used; i > 0; i = i - 1)
+        {
+            sSyndromeSegment *segment = &segments[i - 1];
+            unsigned int size = (segment->begin < decodeWordSize) ? (decodeWordSize - segment->begin) : 0;
+            if(segment->clean)
+            {
+                if(state == segment->last)                  //путь участка без ошибок, символы уже выданы
+                {
+                    state = segment->first;
+                    continue;
+                }
+                for(path = 0; path < S; path = path + 1)    //восстановление решений участка
+                {
+                    metric[path] = distanceTable[path ^ segment->first];
+                }
+                forward(codeWord, hardFill, 0, segment->begin, segment->end - segment->begin, metric,
+                        decisions + segment->begin);
+            }
+            state = traceback(decisions + segment->begin, segment->end - segment->begin, state,
+                              decodeWord, size);
+        }
+    }
+    free(decisions);
+    free(segments);
+    if(!ok || dense)                                        //нехватка памяти или частые ошибки - полный проход
+    {
+        return decodeTerminated(codeWord, hardFill, 0, steps, decodeWord, decodeWordSize);
+    }
+    return true;
+}
+
+/**
+ * @brief инициализация контекста декодера поиском по дереву
+ * @param
+ *  decoder - указатель на контекст
+ */
+void treeDecoderInit(sTreeDecoder *decoder)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->pathTree = TREE_NONE;
+}
+
+/**
+ * @brief освобождение памяти контекста декодера поиском по дереву
  * @param
+ *  decoder - указатель на контекст
+ */
+void treeDecoderFree(sTreeDecoder *decoder)
+{
+    treeFree(&decoder->pool);
+    decoder->pathTree = TREE_NONE;
+}
+
+/**
+ * @brief функция запускает декодирование слова поиском по дереву вероятных
+ *        путей с глубиной DEPTH (исходный декодер, см. viterby) в контексте
+ *        decoder. Кодовое слово не должно превышать S последовательностей из
+ *        N символов
+ * @param
+ *  decoder - указатель на контекст декодера (пул узлов сохраняется между вызовами)
  *  codeWord - массив кодовых символов
  *  codeWordSize - размер мдекодированный массив
  *  decodeWordSize - размер выходного декодированного массива
  *  decodeWord - декодированное слово
  */
-void getDecode(unsigned int *codeWord, unsigned int codeWordSize,
-               unsigned int *decodeWord, unsigned int decodeWordSize)
+void getDecodeTreeWith(sTreeDecoder *decoder, unsigned int *codeWord, unsigned int codeWordSize,
+                       unsigned int *decodeWord, unsigned int decodeWordSize)
 {
-    splitWord(codeWord, codeWordSize, NSequences, &NSize);  //разбиение закодированного слова
+    initTables();
+    splitWord(codeWord, codeWordSize, decoder->NSequences, &decoder->NSize);  //разбиение закодированного слова
+    treeReset(&decoder->pool);                              //дерево предыдущего слова не используется
+    decoder->pathTree = TREE_NONE;
 
     unsigned int NSIndex = 0;   //инициализация итератора массива последовательностей из N символов
     sPath path[S];              //массив, хранящий в себевсе возможные пути до узла назначения
-    unsigned int pathSize;      //размер массива path
+    unsigned int pathSize = 0;  //размер массива path
+    memset(path, 0, sizeof(path));  //результат не зависит от содержимого стека вызывающего потока
     unsigned int depth;         //глубина поиска
     bool visit = false;         //флаг, отмечающий посещенный узел дерева путей
     bool isFirst = true;        //флаг, отмещающий, что дерево путей создано впервые
@@ -47,41 +1361,563 @@ void getDecode(unsigned int *codeWord, unsigned int codeWordSize,
     unsigned int checked[chSize];           //массив, содержащий узлы наиболее вероятного пути
     unsigned int index = 0;     //текущий индекс массива, содержащего наиболее вероятный путь
 
-    while(NSIndex < NSize)      //пока NSIndex меньше размера  массива последовательностей из N символов
+    while(NSIndex < decoder->NSize)     //пока NSIndex меньше размера  массива последовательностей из N символов
     {
         clearPath(path, pathSize+1);                                                //очищение массива путей
         pathSize = 0;                                                               //сброс размера массива путей
         depth = 0;                                                                  //сброс глубины поиска
-        pathTree = viterby(pathTree, &NSIndex, &depth);                             //вызов функции, реализующей алгоритм Витерби
+        decoder->pathTree = viterby(decoder, decoder->pathTree, &NSIndex, &depth);  //вызов функции, реализующей алгоритм Витерби
 
-        getPaths(pathTree, path, &pathSize, &visit, &isFirst);                      //получение массива вероятных путей
+        getPaths(&decoder->pool, decoder->pathTree, path, &pathSize, &visit, &isFirst); //получение массива вероятных путей
         isFirst = false;                                                            //сброс флага, так как дерево путей уже было создано
 
         unsigned int lastNode = checkPath(checked, chSize, &index, path, pathSize); //выбор наиболее оптимального пути. Переменная lastNode хранит последний пройденный узел выбранного пути
-        removeTree(pathTree);                                                       //удаление дерева путей
-        pathTree = NULL;                                                            //установка указателя на дерево путей в NULL
-        pathTree = addNode(lastNode, NSIndex, pathTree, true);                      //добавление в дерево путей последнего пройденного узла (lastNode)
+        treeReset(&decoder->pool);                                                  //удаление дерева путей: все узлы окна освобождаются сбросом пула
+        decoder->pathTree = addNode(&decoder->pool, lastNode, NSIndex, TREE_NONE, true);  //добавление в дерево путей последнего пройденного узла (lastNode)
     }
 
     decode(decodeWord, decodeWordSize, checked, chSize);    //декодирование последовательности символов на основании полученного пути
 }
 
+/**
+ * @brief функция запускает декодирование слова поиском по дереву вероятных
+ *        путей (см. getDecodeTreeWith) во временном контексте
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер мдекодированный массив
+ *  decodeWordSize - размер выходного декодированного массива
+ *  decodeWord - декодированное слово
+ */
+void getDecodeTree(unsigned int *codeWord, unsigned int codeWordSize,
+                   unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    sTreeDecoder decoder;       //контекст декодера
+    treeDecoderInit(&decoder);
+    getDecodeTreeWith(&decoder, codeWord, codeWordSize, decodeWord, decodeWordSize);
+    treeDecoderFree(&decoder);
+}
+
+/**
+ * @brief сброс метрик потокового декодера в нулевое начальное состояние
+ * @param
+ *  decoder - указатель на контекст декодера
+ */
+static void decoderReset(sDecoder *decoder)
+{
+    unsigned int state;
+    for(state = 0; state < S; state = state + 1)
+    {
+        decoder->metric[state] = (state == 0) ? 0 : 0x1000;
+    }
+    decoder->head = 0;
+    decoder->stored = 0;
+    decoder->pendingCount = 0;
+    decoder->earlyWait = 0;
+}
+
+/**
+ * @brief обратный проход по кольцевому буферу потокового декодера. Символы
+ *        emit самых старых шагов записываются в output в порядке следования
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  state - состояние после шага from
+ *  from - количество самых старых сохраненных шагов, от конца которых
+ *         начинается проход (более новые шаги не просматриваются)
+ *  emit - количество выдаваемых символов, не более from
+ *  output - буфер декодированных символов
+ */
+static void decoderTraceback(const sDecoder *decoder, unsigned int state, unsigned int from, unsigned int emit,
+                             unsigned int *output)
+{
+    unsigned int ring = 2*decoder->depth;                   //размер кольцевого буфера
+    unsigned int position = (decoder->head + ring - (decoder->stored - from)) % ring;  //позиция в буфере после шага t
+    unsigned int t = from;                                  //итератор по шагам
+    while(t > emit)                                         //шаги, символы которых выдаются позже
+    {
+        t = t - 1;
+        position = (position == 0) ? (ring - 1) : (position - 1);
+        state = tracebackStep(decoder->decisions[position], state);
+    }
+    while(t > 0)
+    {
+        t = t - 1;
+        position = (position == 0) ? (ring - 1) : (position - 1);
+        output[t] = state & 1;
+        state = tracebackStep(decoder->decisions[position], state);
+    }
+}
+
+/**
+ * @brief выдача символов emit самых старых шагов кольцевого буфера в output
+ *        (или во временный буфер) и в функцию получения символов
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  state - состояние после шага from
+ *  from - количество самых старых сохраненных шагов, за которыми следует state
+ *  emit - количество выдаваемых символов, не более from
+ *  output - буфер декодированных символов (NULL - только callback)
+ * @return количество выданных символов
+ */
+static unsigned int decoderEmit(sDecoder *decoder, unsigned int state, unsigned int from, unsigned int emit,
+                                unsigned int *output)
+{
+    unsigned int buffer[2*DECODER_MAX_DEPTH];               //символы при отсутствии буфера output
+    unsigned int *bits = output ? output : buffer;
+    decoderTraceback(decoder, state, from, emit, bits);
+    decoder->stored = decoder->stored - emit;
+    if(decoder->callback)
+    {
+        decoder->callback(decoder->context, bits, emit);
+    }
+    return emit;
+}
+
+/**
+ * @brief четные разряды слова, сжатые в младшие 32 разряда
+ * @param
+ *  x - слово
+ */
+static inline uint64_t evenBits(uint64_t x)
+{
+    x = x & 0x5555555555555555ull;
+    x = (x | (x >> 1)) & 0x3333333333333333ull;
+    x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+    x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+    x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+    return (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+}
+
+/**
+ * @brief поиск схождения выживших путей: обратный проход множества состояний
+ *        (бит state - состояние на пути выжившего) от последнего шага. Состояния
+ *        2k и 2k+1 ведут в k, если выжил путь из младшего предшественника, и в
+ *        k + S/2 - если из старшего. Когда во множестве остается одно состояние,
+ *        все более старые шаги решены однозначно
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  merged - состояние, через которое проходят все выжившие пути
+ * @return количество самых старых сохраненных шагов, общих для всех выживших путей
+ */
+static unsigned int decoderMerged(const sDecoder *decoder, unsigned int *merged)
+{
+    unsigned int ring = 2*decoder->depth;                   //размер кольцевого буфера
+    unsigned int position = decoder->head;                  //позиция в буфере после шага
+    uint64_t set = ~(uint64_t)0 >> (64 - S);                //состояния выживших путей
+    unsigned int k;                                         //количество пройденных шагов
+    for(k = 1; k <= decoder->stored; k = k + 1)
+    {
+        position = (position == 0) ? (ring - 1) : (position - 1);
+        uint64_t decision = decoder->decisions[position];
+        set = evenBits((set & ~decision) | ((set & ~decision) >> 1))
+            | (evenBits((set & decision) | ((set & decision) >> 1)) << (S/2));
+        if(!(set & (set - 1)))                              //осталось одно состояние
+        {
+            *merged = __builtin_ctzll(set);
+            return decoder->stored - k;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief инициализация контекста потокового декодера (нулевое начальное состояние)
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  depth - глубина обратного прохода, от SIZE+1 до DECODER_MAX_DEPTH
+ *          (0 - DECODER_DEPTH)
+ * @return true, если глубина допустима
+ */
+bool decoderInit(sDecoder *decoder, unsigned int depth)
+{
+    if(depth == 0)
+    {
+        depth = DECODER_DEPTH;
+    }
+    if((depth < SIZE + 1) || (depth > DECODER_MAX_DEPTH))
+    {
+        return false;
+    }
+    initTables();                                           //построение таблиц конечного автомата при первом вызове
+    buildSoftTables();
+    decoder->depth = depth;
+    decoder->early = false;
+    decoder->callback = NULL;
+    decoder->context = NULL;
+    decoderReset(decoder);
+    return true;
+}
+
+/**
+ * @brief включение режима ранних решений (см. viterby.h)
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  callback - функция получения выданных символов (NULL - только буфер output)
+ *  context - указатель, передаваемый в callback
+ */
+void decoderSetEarly(sDecoder *decoder, tDecoderOutput callback, void *context)
+{
+    decoder->early = true;
+    decoder->callback = callback;
+    decoder->context = context;
+}
+
+/**
+ * @brief декодирование очередной части потока (см. coderPush). Часть может
+ *        иметь любую длину, в том числе не кратную N. Символы выдаются в порядке
+ *        следования в потоке с задержкой от depth до 2*depth шагов (в режиме
+ *        ранних решений - как только сошлись выжившие пути)
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  codeWord - кодовые символы части потока (0, 1 или ERASURE)
+ *  len - количество кодовых символов
+ *  output - буфер декодированных символов, не менее (len + N - 1)/N + 2*depth
+ *           элементов (NULL - символы передаются только в callback)
+ * @return количество выданных символов
+ */
+unsigned int decoderPush(sDecoder *decoder, const unsigned int *codeWord, unsigned int len,
+                         unsigned int *output)
+{
+    uint16_t branch[ACS_CHUNK][1 << N];                     //метрики ветвей порции шагов
+    unsigned int ring = 2*decoder->depth;                   //размер кольцевого буфера
+    unsigned int emitted = 0;                               //количество выданных символов
+
+    while(len > 0)
+    {
+        unsigned int count;                                 //количество шагов порции
+        if(decoder->pendingCount > 0)                       //дополнение неполного шага
+        {
+            while((decoder->pendingCount < N) && (len > 0))
+            {
+                decoder->pending[decoder->pendingCount] = *codeWord;
+                decoder->pendingCount = decoder->pendingCount + 1;
+                codeWord = codeWord + 1;
+                len = len - 1;
+            }
+            if(decoder->pendingCount < N)
+            {
+                break;
+            }
+            hardFill(decoder->pending, 0, 0, 1, branch);
+            decoder->pendingCount = 0;
+            count = 1;
+        }
+        else
+        {
+            count = len / N;
+            if(count == 0)                                  //остаток неполного шага сохраняется до следующей части
+            {
+                for(; len > 0; len = len - 1)
+                {
+                    decoder->pending[decoder->pendingCount] = *codeWord;
+                    decoder->pendingCount = decoder->pendingCount + 1;
+                    codeWord = codeWord + 1;
+                }
+                break;
+            }
+            count = (count < ACS_CHUNK) ? count : ACS_CHUNK;
+            hardFill(codeWord, 0, 0, count, branch);
+            codeWord = codeWord + N*count;
+            len = len - N*count;
+        }
+
+        unsigned int done = 0;                              //обработанные шаги порции
+        while(done < count)
+        {
+            unsigned int segment = count - done;            //шаги до конца буфера или до его заполнения
+            if(segment > ring - decoder->head)
+            {
+                segment = ring - decoder->head;
+            }
+            if(segment > ring - decoder->stored)
+            {
+                segment = ring - decoder->stored;
+            }
+            acsRun(decoder->metric, branch + done, segment, decoder->decisions + decoder->head);
+            decoder->head = (decoder->head + segment) % ring;
+            decoder->stored = decoder->stored + segment;
+            done = done + segment;
+            decoder->earlyWait = (decoder->earlyWait > segment) ? (decoder->earlyWait - segment) : 0;
+            if(decoder->early && (decoder->earlyWait == 0)) //выдача символов, общих для всех выживших путей
+            {
+                unsigned int state = 0;                     //состояние в точке схождения
+                unsigned int merged = decoderMerged(decoder, &state);
+                if(merged > 0)
+                {
+                    emitted = emitted + decoderEmit(decoder, state, merged, merged, output ? (output + emitted) : NULL);
+                }
+                decoder->earlyWait = decoder->stored;       //следующий поиск - через отставание точки схождения
+            }
+            if(decoder->stored == ring)                     //буфер заполнен - выдача depth самых старых символов
+            {
+                emitted = emitted + decoderEmit(decoder, bestState(decoder->metric), decoder->stored, decoder->depth,
+                                                output ? (output + emitted) : NULL);
+            }
+        }
+    }
+    return emitted;
+}
+
+/**
+ * @brief завершение потока, закодированного с хвостом из SIZE-1 нулей
+ *        (см. coderFlush): выдача оставшихся символов без хвоста и возврат
+ *        декодера в нулевое начальное состояние
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  output - буфер декодированных символов, не менее 2*depth элементов
+ * @return количество выданных символов
+ */
+unsigned int decoderFlush(sDecoder *decoder, unsigned int *output)
+{
+    unsigned int tailMask = (1u << (SIZE - 1)) - 1;         //разряды состояния, обнуленные хвостом
+    unsigned int best = S;                                  //конечное состояние наиболее вероятного пути
+    unsigned int state;
+    unsigned int emit = 0;                                  //количество выдаваемых символов
+    for(state = 0; state < S; state = state + 1)
+    {
+        if(!(state & tailMask) && ((best == S) || ((int16_t)(decoder->metric[state] - decoder->metric[best]) < 0)))
+        {
+            best = state;
+        }
+    }
+    if(decoder->stored > SIZE - 1)
+    {
+        emit = decoderEmit(decoder, best, decoder->stored, decoder->stored - (SIZE - 1), output);
+    }
+    decoderReset(decoder);
+    return emit;
+}
+
+/**
+ * @brief прямой проход по шагам циклически продолженного слова: шаг с номером
+ *        first + t соответствует шагу (first + t) mod steps слова
+ * @param
+ *  codeWord - массив кодовых символов
+ *  steps - количество шагов слова
+ *  first - номер первого шага прохода, меньше steps
+ *  count - количество шагов прохода
+ *  metric - метрики путей до прохода, после выполнения - после прохода
+ *  decisions - решения шагов прохода
+ */
+static void forwardCyclic(const unsigned int *codeWord, unsigned int steps, unsigned int first,
+                          unsigned int count, uint16_t metric[S], uint64_t *decisions)
+{
+    while(count > 0)                                        //по непрерывным участкам до конца слова
+    {
+        unsigned int part = (steps - first < count) ? (steps - first) : count;
+        forward(codeWord, hardFill, 0, first, part, metric, decisions);
+        decisions = decisions + part;
+        count = count - part;
+        first = 0;
+    }
+}
+
+/**
+ * @brief функция декодирует слово, закодированное с циклическим завершением
+ *        (см. getCodeWordTailBiting). Слово циклически продолжается на TB_WRAP
+ *        шагов перед началом (метрики сходятся к метрикам конца слова) и после
+ *        конца (обратный проход начинается с лучшего состояния в конце
+ *        продолжения, поэтому решения последних шагов слова учитывают начало
+ *        слова). Слово короче TB_WRAP шагов декодируется по максимуму
+ *        правдоподобия: проход выполняется для каждого начального состояния,
+ *        выбирается лучший путь, вернувшийся в свое начальное состояние
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов (N символов на входной символ)
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти (слово не декодируется)
+ */
+bool getDecodeTailBiting(unsigned int *codeWord, unsigned int codeWordSize,
+                         unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    initTables();                                           //построение таблиц конечного автомата при первом вызове
+    buildSoftTables();
+    unsigned int steps = codeWordSize / N;                  //количество шагов решетки
+    if(steps == 0)
+    {
+        return true;
+    }
+    uint64_t *decisions = malloc(((size_t)steps + 2*TB_WRAP) * sizeof(uint64_t));   //решения слова с продолжениями
+    if(!decisions)
+    {
+        return false;
+    }
+    uint16_t metric[S];                                     //метрики путей
+    unsigned int state;
+
+    if(steps < TB_WRAP)     //короткое слово: продолжения не успевают сойтись, начальное состояние перебирается
+    {
+        unsigned int best = 0;                              //начальное (и конечное) состояние лучшего пути
+        uint16_t bestMetric = 0;
+        unsigned int start;
+        for(start = 0; start < S; start = start + 1)
+        {
+            for(state = 0; state < S; state = state + 1)
+            {
+                metric[state] = (state == start) ? 0 : 0x1000;
+            }
+            forward(codeWord, hardFill, 0, 0, steps, metric, decisions);
+            if((start == 0) || ((int16_t)(metric[start] - bestMetric) < 0))
+            {
+                best = start;
+                bestMetric = metric[start];
+            }
+        }
+        for(state = 0; state < S; state = state + 1)
+        {
+            metric[state] = (state == best) ? 0 : 0x1000;
+        }
+        forward(codeWord, hardFill, 0, 0, steps, metric, decisions);
+        traceback(decisions, steps, best, decodeWord, decodeWordSize);
+        free(decisions);
+        return true;
+    }
+
+    for(state = 0; state < S; state = state + 1)            //начальное состояние неизвестно
+    {
+        metric[state] = 0;
+    }
+    forwardCyclic(codeWord, steps, steps - TB_WRAP % steps, TB_WRAP, metric, decisions);
+    forwardCyclic(codeWord, steps, 0, steps + TB_WRAP, metric, decisions + TB_WRAP);
+
+    //шаги продолжения после конца слова не выдаются (см. traceback)
+    traceback(decisions + TB_WRAP, steps + TB_WRAP, bestState(metric), decodeWord, decodeWordSize);
+    free(decisions);
+    return true;
+}
+
+/**
+ * @brief функция декодирует слово, закодированное произвольным сверточным кодом
+ *        (см. trellisEncode), по алгоритму Витерби на решетке кода. Начальное
+ *        состояние нулевое; если слово содержит полный хвост из K-2 нулей,
+ *        обратный проход начинается с лучшего из состояний, допустимых после хвоста
+ * @param
+ *  trellis - решетка кода (см. buildTrellis)
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти (слово не декодируется)
+ */
+bool trellisDecode(const sTrellis *trellis, const unsigned int *codeWord, unsigned int codeWordSize,
+                   unsigned int *decodeWord, unsigned int decodeWordSize)
+{
+    unsigned int outputs = trellis->spec.outputs;           //количество выходов кода
+    unsigned int states = trellis->states;                  //количество состояний
+    unsigned int steps = codeWordSize / outputs;            //количество шагов решетки
+    unsigned int words = (states + 63) / 64;                //64-разрядных слов решений на шаг
+    if(steps == 0)
+    {
+        return true;
+    }
+    uint32_t *metric = malloc(2 * states * sizeof(uint32_t));   //метрики путей до и после шага
+    uint64_t *decisions = calloc((size_t)steps * words, sizeof(uint64_t));
+    if(!metric || !decisions)
+    {
+        free(metric);
+        free(decisions);
+        return false;
+    }
+    uint32_t branch[1 << MAX_OUTPUTS];                      //метрики ветвей шага
+    uint32_t *oldMetric = metric;
+    uint32_t *newMetric = metric + states;
+    unsigned int state;
+    unsigned int t;                                         //итератор по шагам
+
+    for(state = 0; state < states; state = state + 1)       //начальное состояние - нулевое
+    {
+        oldMetric[state] = (state == 0) ? 0 : (1u << 24);
+    }
+
+    for(t = 0; t < steps; t = t + 1)
+    {
+        const unsigned int *symbols = codeWord + outputs*t; //принятые символы шага
+        unsigned int code;
+        for(code = 0; code < (1u << outputs); code = code + 1)
+        {
+            uint32_t value = 0;
+            unsigned int k;
+            for(k = 0; k < outputs; k = k + 1)
+            {
+                if((symbols[k] != ERASURE) && (symbols[k] != ((code >> (outputs - 1 - k)) & 1)))
+                {
+                    value = value + 1;
+                }
+            }
+            branch[code] = value;
+        }
+
+        uint64_t *stepDecisions = decisions + (size_t)t * words;
+        for(state = 0; state < states; state = state + 1)
+        {
+            unsigned int bit = state & 1;                   //входной символ перехода
+            unsigned int low = trellis->prevState[2*state];
+            unsigned int high = trellis->prevState[2*state + 1];
+            uint32_t metric0 = oldMetric[low] + branch[trellis->output[2*low + bit]];
+            uint32_t metric1 = oldMetric[high] + branch[trellis->output[2*high + bit]];
+            if((int32_t)(metric0 - metric1) > 0)
+            {
+                newMetric[state] = metric1;
+                stepDecisions[state / 64] |= (uint64_t)1 << (state % 64);
+            }
+            else
+            {
+                newMetric[state] = metric0;
+            }
+        }
+        uint32_t *swap = oldMetric;
+        oldMetric = newMetric;
+        newMetric = swap;
+    }
+
+    unsigned int tailMask = 0;                              //разряды состояния, обнуленные хвостом
+    if(steps >= decodeWordSize + trellis->spec.K - 2)
+    {
+        tailMask = (1u << (trellis->spec.K - 2)) - 1;
+    }
+    unsigned int best = states;                             //конечное состояние наиболее вероятного пути
+    for(state = 0; state < states; state = state + 1)
+    {
+        if(!(state & tailMask) && ((best == states) || ((int32_t)(oldMetric[state] - oldMetric[best]) < 0)))
+        {
+            best = state;
+        }
+    }
+
+    state = best;
+    t = steps;
+    while(t > 0)                                            //обратный проход
+    {
+        t = t - 1;
+        if(t < decodeWordSize)
+        {
+            decodeWord[decodeWordSize - 1 - t] = state & 1;
+        }
+        unsigned int d = (decisions[(size_t)t * words + state / 64] >> (state % 64)) & 1;
+        state = trellis->prevState[2*state + d];
+    }
+    free(metric);
+    free(decisions);
+    return true;
+}
+
 /**
  * @brief фкнуция получения вероятных путей по алгоритму Витерби.
  * @param
- *  tree - указатель на текущий узел дерева возможных путей
+ *  decoder - указатель на контекст декодера
+ *  tree - номер текущего узла дерева возможных путей
  *  NSInd - текущий индекс массива последовательносте из N-символов
  *  depth - глубина поиска
  */
-sTree *viterby(sTree *tree, unsigned int *NSInd, unsigned int *depth)
+uint32_t viterby(sTreeDecoder *decoder, uint32_t tree, unsigned int *NSInd, unsigned int *depth)
 {
     unsigned int counter = 0;               //инициализация счетчика количества несовпадений
     bool left = true;                       //логический флаг, который определяет, в какое поддерево добавится новый узел: в левое или в правое
     unsigned int state;                     //текущее состояние конечного автомата
 
-    if(tree != NULL)                        //если дерево путей не пустое
+    if(tree != TREE_NONE)                   //если дерево путей не пустое
     {
-        state = tree->data;                 //установка начального состояния в значение последнего узла дерева
+        state = decoder->pool.nodes[tree].data;                 //установка начального состояния в значение последнего узла дерева
     }
     else                                    //иначе
     {
@@ -97,10 +1933,10 @@ sTree *viterby(sTree *tree, unsigned int *NSInd, unsigned int *depth)
             {
                 unsigned int index = jumpTable[state][j];           //запись в index значения состояния, в которое возможен следующий переход
 
-                if(arrCmp(NSequences[*NSInd], codeTable[index], N)) //если текущая последовательность совпадает с значением кодовой последовательности состояния index
+                if(arrCmp(decoder->NSequences[*NSInd], codeTable[index], N)) //если текущая последовательность совпадает с значением кодовой последовательности состояния index
                 {
                     counter = 0;                                    //сброс счетчика
-                    tree = addNode(index, *NSInd, tree, left);      //добавление в дерево путей значения переменной index
+                    tree = addNode(&decoder->pool, index, *NSInd, tree, left);      //добавление в дерево путей значения переменной index
                     *depth = *depth + 1;                            //увеличение текущей глубины дерева на 1
 
                     *NSInd = *NSInd + 1;                            //переход к новой последовательности из N символов
@@ -115,33 +1951,44 @@ sTree *viterby(sTree *tree, unsigned int *NSInd, unsigned int *depth)
                     {
                         counter = 0;                                //сброс счетчика
 
-                        if(!tree)                                   //если дерево путей пустое
+                        if(tree == TREE_NONE)                       //если дерево путей пустое
                         {
-                            tree = addNode(index, *NSInd, tree, true);                      //добавить в дерево 1
+                            tree = addNode(&decoder->pool, index, *NSInd, tree, true);                      //добавить в дерево 1
+                            if(tree == TREE_NONE)                   //если память под узел не выделена
+                            {
+                                break;
+                            }
                             *depth = *depth + 1;                                        //увеличение текущей глубины дерева
-                            hammingCounter(tree, NSequences[*NSInd], codeTable[index]); //подсчет метрики Хэмминга для текущего узла
+                            hammingCounter(&decoder->pool.nodes[tree], decoder->NSequences[*NSInd], codeTable[index]); //подсчет метрики Хэмминга для текущего узла
 
                             *NSInd = *NSInd + 1;                    //перехорд к следующей последовательности из N символов
-                            viterby(tree, NSInd, depth);            //рекурсивный вызов функции для текущего дерева путей
+                            viterby(decoder, tree, NSInd, depth);            //рекурсивный вызов функции для текущего дерева путей
                         }
                         else                                        //иначе
                         {
-                            tree = addNode(index, *NSInd, tree, false);                                 //добавить в правое поддерево значение index
+                            tree = addNode(&decoder->pool, index, *NSInd, tree, false);                                 //добавить в правое поддерево значение index
                             *depth = *depth + 1;                                                        //увеличить текущую глубину дерева
-                            hammingCounter((sTree*)tree->right, NSequences[*NSInd], codeTable[index]);  //подсчет метрики Хэмминга для текущего узла дерева путей
+                            if(decoder->pool.nodes[tree].right != TREE_NONE)
+                            {
+                                hammingCounter(&decoder->pool.nodes[decoder->pool.nodes[tree].right], decoder->NSequences[*NSInd], codeTable[index]);  //подсчет метрики Хэмминга для текущего узла дерева путей
+                            }
 
                             index = jumpTable[state][j - 1];                                            //запись в переменную index значения предыдущего состояния (так как в этом состоянии последовательности также не совпали)
-                            tree = addNode(index, *NSInd, tree, true);                                  //добавить в левое поддерево значение index
-                            hammingCounter((sTree*)tree->left, NSequences[*NSInd], codeTable[index]);
+                            tree = addNode(&decoder->pool, index, *NSInd, tree, true);                                  //добавить в левое поддерево значение index
+                            if(decoder->pool.nodes[tree].left == TREE_NONE)  //если память под узлы не выделена
+                            {
+                                break;
+                            }
+                            hammingCounter(&decoder->pool.nodes[decoder->pool.nodes[tree].left], decoder->NSequences[*NSInd], codeTable[index]);
 
                             *NSInd = *NSInd + 1;                            //переход к ледующей последовательности из N символов
-                            viterby((sTree*)tree->right, NSInd, depth);     //рекурсивный вызов функции для правого поддерева
+                            viterby(decoder, decoder->pool.nodes[tree].right, NSInd, depth);  //рекурсивный вызов функции для правого поддерева
 
 
-                            sTree *tmp = (sTree*)tree->left;                //запись в указатель tmp указателя на левое поддерево
-                            *NSInd = tmp->codeIndex;                        //установка идекса массива последовательностей в точку ветвления дерева
+                            uint32_t tmp = decoder->pool.nodes[tree].left;       //номер левого поддерева (пул мог быть перемещен при рекурсивном вызове)
+                            *NSInd = decoder->pool.nodes[tmp].codeIndex;         //установка идекса массива последовательностей в точку ветвления дерева
                             *NSInd = *NSInd + 1;                            //переход к следющему элементу массива последовательностей
-                            viterby((sTree*)tree->left, NSInd, depth);      //рекурсивный вызов функции для левого поддерева
+                            viterby(decoder, tmp, NSInd, depth);                     //рекурсивный вызов функции для левого поддерева
                         }
                         break;                                              //выход из цикла
                     }
@@ -176,7 +2023,8 @@ void clearPath(sPath path[S], unsigned int pathSize)
 /**
  * @brief фкнуция подсчета метрики Хэмминга.
  *        Метрика Хэмминга рассчитывается как количество
- *        различающихся символов в двух массивах.
+ *        различающихся символов в двух массивах. Стертые символы
+ *        (ERASURE) первого массива не учитываются.
  * @param
  *  tree - указатель на текущий узел дерева путей
  *  array_1 - указатель на первый массив
@@ -188,7 +2036,7 @@ void hammingCounter(sTree *tree, unsigned int *array_1, unsigned int *array_2)
     int counter = 0;    //инициализация счетчика
     for(i = 0; i < N; i = i + 1)
     {
-        if(array_1[i] != array_2[i])    //если символ массива 1 не равен символу массива 2
+        if((array_1[i] != ERASURE) && (array_1[i] != array_2[i]))   //если символ массива 1 не стерт и не равен символу массива 2
         {
             counter = counter + 1;      //увеличение счетчика
         }
@@ -249,34 +2097,43 @@ unsigned int getMin(sPath path[S], unsigned int size)
 /**
  * @brief функция добавляет в дерево вероятных путей новый узел
  * @param
+ *  pool - указатель на пул узлов дерева
  *  data - значение нового узла дерева
  *  codeIndex - индекс массива последовательностей, при котором произошло ветвление
- *  node - указатель на новый узел дерева
+ *  node - номер узла дерева (TREE_NONE - создать новый узел)
  *  left -  флаг, указывающий, в какое поддерево будет добавлен нвый узел.
  *          При left = true узел будет добавлен в левое поддерево, иначе - в правое.
  */
-sTree *addNode(unsigned int data, unsigned int codeIndex,
-               sTree *node, bool left)
+uint32_t addNode(sTreePool *pool, unsigned int data, unsigned int codeIndex,
+                 uint32_t node, bool left)
 {
-    if(!node)                                   //если указатель на узел равен NULL
+    if(node == TREE_NONE)                       //если узла нет
     {
-        node = (sTree*) malloc(sizeof(sTree));  //выделяем память под указатель
-        node->data = data;                      //запись значения узла
-        node->metric = 0;                       //инициализация значения метрики узла
-        node->codeIndex = codeIndex;            //запись индекса ветвления узла
-        node->left = NULL;                      //инициализация указателя на левое поддерево узла
-        node->right = NULL;                     //инициализация указателя на правое поддерево узла
-        node->parent = NULL;                    //инициализация указателя на родительский узел
+        node = treeAlloc(pool);            //выделяем узел из пула
+        if(node == TREE_NONE)                   //если память не выделена
+        {
+            return node;
+        }
+        sTree *tree = &pool->nodes[node];
+        tree->data = data;                      //запись значения узла
+        tree->metric = 0;                       //инициализация значения метрики узла
+        tree->codeIndex = codeIndex;            //запись индекса ветвления узла
+        tree->left = TREE_NONE;                 //инициализация левого поддерева узла
+        tree->right = TREE_NONE;                //инициализация правого поддерева узла
+        tree->parent = TREE_NONE;               //инициализация родительского узла
     }
     else                                        //иначе
     {
+        uint32_t branch;                        //номер узла поддерева
         if(left)                                //если left = true
         {
-            node->left = createBranch(data, codeIndex, (sTree*)node->left, node, left);     //создание левого поддерева
+            branch = createBranch(pool, data, codeIndex, pool->nodes[node].left, node, left);  //создание левого поддерева
+            pool->nodes[node].left = branch; //пул мог быть перемещен, поэтому узел берется заново
         }
         else                                    //иначе
         {
-            node->right = createBranch(data, codeIndex, (sTree*)node->right, node, left);   //создание правого поддерева
+            branch = createBranch(pool, data, codeIndex, pool->nodes[node].right, node, left); //создание правого поддерева
+            pool->nodes[node].right = branch;
         }
     }
     return node;
@@ -285,33 +2142,73 @@ sTree *addNode(unsigned int data, unsigned int codeIndex,
 /**
  * @brief функция добавляет в поддерево вероятных путей новый узел
  * @param
+ *  pool - указатель на пул узлов дерева
  *  data - значение нового узла дерева
  *  codeIndex - индекс массива последовательностей, при котором произошло ветвление
- *  node - указатель на новый узел дерева
+ *  node - номер узла дерева (TREE_NONE - создать новый узел)
  *  left -  флаг, указывающий, в какое поддерево будет добавлен нвый узел.
- *  parent - указатель на родительский узел
+ *  parent - номер родительского узла
  */
-sTree * createBranch(unsigned int data, unsigned int codeIndex,
-                     sTree *node, sTree *parent, bool left)
+uint32_t createBranch(sTreePool *pool, unsigned int data, unsigned int codeIndex,
+                      uint32_t node, uint32_t parent, bool left)
 {
-    node = addNode(data, codeIndex, node, left);    //добавление нового узла в поддерево
-    node->parent = parent;                          //добавление указателя на родительский узел
+    node = addNode(pool, data, codeIndex, node, left);    //добавление нового узла в поддерево
+    if(node != TREE_NONE)
+    {
+        pool->nodes[node].parent = parent;       //добавление родительского узла
+    }
     return node;
 }
 
 /**
- * @brief Функция удаляет дерево
+ * @brief выделение узла дерева путей из пула
  * @param
- *  tree - указатель на дерево
+ *  pool - указатель на пул
+ * @return номер узла или TREE_NONE, если память не выделена
  */
-void removeTree(sTree *tree)
+uint32_t treeAlloc(sTreePool *pool)
 {
-    if(!tree)                               //пока существует указатель на дерево
+    if(pool->used <= TREE_NONE)                 //элемент TREE_NONE не выдается
+    {
+        pool->used = TREE_NONE + 1;
+    }
+    if(pool->used >= pool->capacity)            //если массив заполнен, он увеличивается вдвое
     {
-        removeTree((sTree*)tree->left);     //удаление левого поддерева
-        removeTree((sTree*)tree->right);    //удаление правого поддерева
-        free(tree);                         //освобождние памяти текущего указателя на дерево
+        uint32_t capacity = pool->capacity ? 2*pool->capacity : TREE_POOL_INITIAL;
+        sTree *nodes = realloc(pool->nodes, capacity * sizeof(sTree));
+        if((capacity <= pool->capacity) || !nodes)
+        {
+            return TREE_NONE;
+        }
+        pool->nodes = nodes;
+        pool->capacity = capacity;
     }
+    pool->used = pool->used + 1;
+    return pool->used - 1;
+}
+
+/**
+ * @brief сброс пула: все выданные узлы освобождаются за O(1), память массива
+ *        сохраняется
+ * @param
+ *  pool - указатель на пул
+ */
+void treeReset(sTreePool *pool)
+{
+    pool->used = TREE_NONE + 1;
+}
+
+/**
+ * @brief освобождение памяти пула
+ * @param
+ *  pool - указатель на пул
+ */
+void treeFree(sTreePool *pool)
+{
+    free(pool->nodes);
+    pool->nodes = NULL;
+    pool->used = 0;
+    pool->capacity = 0;
 }
 
 /**
@@ -329,14 +2226,10 @@ int checkPath(unsigned int *checked, unsigned int checkedSize, unsigned int *chI
 {
     unsigned int min = getMin(path, pathSize);      //получение индекса пути с минимальной метрикой (т.е. индекса наиболее вероятного пути)
     unsigned int i;                                 //итератор по узлам наиболее ветоятного пути
-    for(i = 0; i < path[min].nodeSize; i = i + 1)
+    for(i = 0; (i < path[min].nodeSize) && (*chIndex < checkedSize); i = i + 1) //запись только в пределах массива
     {
         checked[*chIndex] = path[min].currentNode[i];   //добавление в массив наиболее вероятного пути
         *chIndex = *chIndex + 1;                        //увеличение индекса массива наиболее вероятного пути
-        if(*chIndex > checkedSize - 1)                  //если индекс превышает размер массива
-        {
-            break;                                      //выход из цикла
-        }
     }
     unsigned int lastNode = path[min].currentNode[path[min].nodeSize - 1];  //запись в переменную lastNode значения последнего посещенного узла
     return lastNode;
@@ -345,46 +2238,48 @@ int checkPath(unsigned int *checked, unsigned int checkedSize, unsigned int *chI
 /**
  * @brief Функция анализирует дерево путей и строит на его основе массив вероятных путей
  * @param
- *  tree - указатель на дерево возможных путей
+ *  pool - указатель на пул узлов дерева
+ *  tree - номер корня дерева возможных путей
  *  path - массив путей
  *  size - размер массива путей
  *  visit - флаг посещения узла
  *  isFirst - флаг первого посещения дерева
  */
-void getPaths(sTree *tree, sPath path[S], unsigned int *size,
+void getPaths(const sTreePool *pool, uint32_t tree, sPath path[S], unsigned int *size,
               bool *visit, bool *isFirst)
 {
-    if(!tree->parent && !tree->left && !tree->right)    //если дерево содержит в себе один узел
+    const sTree *node = &pool->nodes[tree];  //текущий узел (пул не изменяется при обходе)
+    if(!node->parent && !node->left && !node->right)    //если дерево содержит в себе один узел
     {
-        appendValue(path, *size, tree);     //добавление в массив путей узла дерева
+        appendValue(path, *size, node);     //добавление в массив путей узла дерева
         return;                             //выход из функции
     }
-    else if(tree->parent)                   //если у текущего узла существует родитель
+    else if(node->parent)                   //если у текущего узла существует родитель
     {
-        appendValue(path, *size, tree);     //добавление в массив путей узла дерева
+        appendValue(path, *size, node);     //добавление в массив путей узла дерева
     }
     else if(*isFirst)                       //если дерево псещается впервые
     {
-        appendValue(path, *size, tree);     //добавление в массив путей узла дерева
+        appendValue(path, *size, node);     //добавление в массив путей узла дерева
         *isFirst = false;                   //сброс флага
     }
 
-    if(tree->left)                                                  //если существует указатель на левое поддерево
+    if(node->left)                                                  //если существует указатель на левое поддерево
     {
         *visit = true;                                              //отмечаем узел посещенным
-        getPaths((sTree*)tree->left, path, size, visit, isFirst);   //рекурсивный вызов функции для левого поддерева
+        getPaths(pool, node->left, path, size, visit, isFirst);   //рекурсивный вызов функции для левого поддерева
     }
-    if(tree->right)                                                 //если существует указатель на правое поддерево
+    if(node->right)                                                 //если существует указатель на правое поддерево
     {
         if(!*visit)                                                 //если текущий узел не посещался
         {
-            if(tree->parent)                                        //если существует указатель на родительский узел
+            if(node->parent)                                        //если существует указатель на родительский узел
             {
-                appendValue(path, *size, tree);                     //добавление в массив путей узла дерева
+                appendValue(path, *size, node);                     //добавление в массив путей узла дерева
             }
         }
         *visit = true;                                              //отмечаем узел посещенным
-        getPaths((sTree*)tree->right, path, size, visit, isFirst);  //рекурсивный вызов функции для правого поддерева
+        getPaths(pool, node->right, path, size, visit, isFirst);  //рекурсивный вызов функции для правого поддерева
     }
     else
     {
@@ -403,7 +2298,7 @@ void getPaths(sTree *tree, sPath path[S], unsigned int *size,
  *  size - текущий размер массива путей
  *  value - указатель на соответствующий узер дерева путей
  */
-void appendValue(sPath path[S], unsigned int size, sTree *value)
+void appendValue(sPath path[S], unsigned int size, const sTree *value)
 {
     int i = path[size].nodeSize;                            //индекс текущего узла для текущего массива путей
     path[size].metric = path[size].metric + value->metric;  //суммирование текущей метрики пути с метрикой добавляемого узла
@@ -23,6 +23,78 @@
  */
 #define DEPTH 10
 
+/**
+ * @brief количество шагов, на которое декодер слов с циклическим завершением
+ *        (tail-biting) продолжает слово циклически перед началом и после конца
+ *        (около 5 длин кодового ограничения)
+ */
+#define TB_WRAP (5*(SIZE+1))
+
+/**
+ * @brief максимальная разрядность квантованных символов (см. getDecodeQuantized)
+ */
+#define SOFT_MAX_BITS 4
+
+/**
+ * @brief количество шагов, метрики ветвей которых считаются перед вызовом
+ *        реализации шагов ACS (см. acs.h)
+ */
+#define ACS_CHUNK 256
+
+/**
+ * @brief глубина обратного прохода потокового декодера по умолчанию (около 5*K)
+ */
+#define DECODER_DEPTH (5*(SIZE + 1))
+
+/**
+ * @brief максимальная глубина обратного прохода потокового декодера
+ */
+#define DECODER_MAX_DEPTH 256
+
+/**
+ * @brief период проверки метрик путей на возврат к виду участка без ошибок
+ *        (начальный, в шагах ACS, см. getDecodeSyndrome)
+ */
+#define SYNDROME_CHECK 8
+
+/**
+ * @brief количество шагов, после которого getDecodeSyndrome переходит к
+ *        полному проходу, если шаги ACS заняли больше половины пройденных
+ *        шагов (ошибки слишком часты, чтобы пропуск шагов окупался)
+ */
+#define SYNDROME_DENSE 256
+
+/**
+ * @brief выравнивание рабочей области декодера (см. getDecodeWorkspace)
+ */
+#define DECODE_WORKSPACE_ALIGN 64
+
+/**
+ * @brief вид кодовых символов для декодирования в рабочей области
+ *  DECODE_HARD - жесткие решения, unsigned int: 0, 1 или ERASURE (см. getDecode)
+ *  DECODE_LLR - мягкие решения, int8_t (см. getDecodeSoft)
+ *  DECODE_QUANTIZED(bits) - квантованные символы из bits разрядов, uint8_t
+ *                           (см. getDecodeQuantized)
+ */
+#define DECODE_HARD 0x000
+#define DECODE_LLR 0x100
+#define DECODE_QUANTIZED(bits) (0x200 | (bits))
+
+/**
+ * @brief номер отсутствующего узла дерева путей. Элемент пула с этим номером
+ *        не выдается, поэтому проверки вида if(tree->left) остаются верными
+ */
+#define TREE_NONE 0
+
+/**
+ * @brief начальная емкость пула узлов дерева путей
+ */
+#define TREE_POOL_INITIAL 1024
+
+#if S > 64
+#error "решения декодера хранятся по биту на состояние в uint64_t"
+#endif
+
 //*****************************Структуры******************************************
 
 /**
@@ -41,90 +113,435 @@ typedef struct
 }sPath;
 
 /**
- * @brief структура sTree описывает дерево вероятных путей
+ * @brief структура sTree описывает дерево вероятных путей. Узлы хранятся
+ *        в пуле treePool и ссылаются друг на друга номерами в пуле
  * Члены структуры:
  *  data        - значение посещенного узла
  *  metric      - метрика Хэмминга для текущего узла
  *  codeIndex   - индекс массива последовательностей, при котором произошло ветвление дерева путей
- *  left        - указатель на левое поддерево
- *  right       - указатель на правое поддерево
- *  parent      - указатель на родительский узел
+ *  left        - номер левого поддерева (TREE_NONE - нет поддерева)
+ *  right       - номер правого поддерева
+ *  parent      - номер родительского узла
  */
 typedef struct
 {
-    unsigned int data;
-    unsigned int metric;
-    unsigned int codeIndex;
-    struct sTree *left;
-    struct sTree *right;
-    struct sTree *parent;
+    uint32_t data;
+    uint32_t metric;
+    uint32_t codeIndex;
+    uint32_t left;
+    uint32_t right;
+    uint32_t parent;
 } sTree;
 
-//*****************************Переменные*****************************************
 /**
- * @brief дерево вероятных путей от текущего узла
+ * @brief структура sTreePool описывает пул узлов дерева путей. Узлы выдаются
+ *        подряд из одного массива, который при нехватке места увеличивается
+ *        вдвое; после выбора выжившего пути пул сбрасывается целиком (treeReset),
+ *        память массива при этом сохраняется для следующего окна
+ * Члены структуры:
+ *  nodes       - массив узлов
+ *  used        - количество выданных узлов, включая элемент TREE_NONE
+ *  capacity    - емкость массива
+ */
+typedef struct
+{
+    sTree *nodes;
+    uint32_t used;
+    uint32_t capacity;
+}sTreePool;
+
+/**
+ * @brief функция получения символов, выданных потоковым декодером
+ * @param
+ *  context - указатель, переданный в decoderSetEarly
+ *  bits - выданные символы в порядке следования в потоке
+ *  count - количество символов
  */
-sTree *pathTree;
+typedef void (*tDecoderOutput)(void *context, const unsigned int *bits, unsigned int count);
 
 /**
- * @brief перечень последовательностей, разбивающих кодовое слово на N символов
- *
- *        ПРИМЕЧАНИЕ: по-хорошему, должна быть динамической, так как размер кодового
- *        слова изначально неизвестен
+ * @brief структура sDecoder описывает контекст потокового декодера Витерби.
+ *        Решения хранятся в кольцевом буфере из 2*depth шагов: когда буфер
+ *        заполнен, обратный проход от лучшего состояния выдает depth самых
+ *        старых символов. Задержка выдачи - от depth до 2*depth шагов, размер
+ *        контекста не зависит от длины потока. В режиме ранних решений символы
+ *        выдаются раньше, как только все выжившие пути сходятся
+ * Члены структуры:
+ *  depth       - глубина обратного прохода
+ *  metric      - метрики путей
+ *  decisions   - кольцевой буфер решений шагов
+ *  head        - позиция в буфере для решений следующего шага
+ *  stored      - количество шагов в буфере, символы которых еще не выданы
+ *  pending     - кодовые символы неполного шага, оставшиеся от предыдущей части
+ *  pendingCount - количество символов в pending
+ *  early       - режим ранних решений
+ *  earlyWait   - шаги до следующего поиска схождения выживших путей (отставание
+ *                точки схождения при предыдущем поиске)
+ *  callback    - функция получения выданных символов (NULL - нет)
+ *  context     - указатель, передаваемый в callback
  */
-unsigned int NSequences[S][N];
+typedef struct
+{
+    unsigned int depth;
+    uint16_t metric[S];
+    uint64_t decisions[2*DECODER_MAX_DEPTH];
+    unsigned int head;
+    unsigned int stored;
+    unsigned int pending[N];
+    unsigned int pendingCount;
+    bool early;
+    unsigned int earlyWait;
+    tDecoderOutput callback;
+    void *context;
+}sDecoder;
 
 /**
- * @brief реальное количество массива последовательностей из N-символов
- *
- *        ПРИМЕЧАНИЕ: является костылем. Если NSequences будет динамической,
- *        нужда в этой переменной отпадет
+ * @brief структура sTreeDecoder описывает контекст декодера поиском по дереву
+ *        (см. getDecodeTreeWith). Контексты независимы, поэтому несколько
+ *        потоков декодируют одновременно, каждый в своем контексте; пул узлов
+ *        сохраняется между вызовами
+ * Члены структуры:
+ *  pool        - пул узлов дерева вероятных путей
+ *  pathTree    - дерево вероятных путей от текущего узла (номер корня в pool)
+ *  NSequences  - перечень последовательностей, разбивающих кодовое слово на N символов
+ *  NSize       - количество последовательностей в NSequences
  */
-unsigned int NSize;
+typedef struct
+{
+    sTreePool pool;
+    uint32_t pathTree;
+    unsigned int NSequences[S][N];
+    unsigned int NSize;
+}sTreeDecoder;
+
 
 //******************************Функции*******************************************
 /**
- * @brief фкнуция запускает декодирование слова по алгоритму Витерби
+ * @brief фкнуция запускает декодирование слова по алгоритму Витерби.
+ *        Для каждого шага решетки выполняется сложение-сравнение-выбор по всем
+ *        S состояниям, решения шагов сохраняются (по биту на состояние), после
+ *        чего наиболее вероятный путь восстанавливается обратным проходом.
+ *        Начальное состояние нулевое; если слово содержит хвост из SIZE-1 нулей
+ *        (см. getCodeWord), обратный проход начинается с лучшего из состояний,
+ *        допустимых после хвоста. Время декодирования - O(codeWordSize*S)
+ *        независимо от количества ошибок. Слово без ошибок и стираний
+ *        декодируется обращением кода за O(codeWordSize) без поиска по решетке
+ *        (см. getDecodeFastStats); результат при этом тот же
  * @param
  *  codeWord - массив кодовых символов
  *  codeWordSize - размер мдекодированный массив
  *  decodeWordSize - размер выходного декодированного массива
  *  decodeWord - декодированное слово
+ * @return false при нехватке памяти
  */
-void getDecode(unsigned int *codeWord, unsigned int codeWordSize,
+bool getDecode(unsigned int *codeWord, unsigned int codeWordSize,
                unsigned int *decodeWord, unsigned int decodeWordSize);
 
+/**
+ * @brief статистика быстрого пути getDecode (счетчики с начала работы программы)
+ * @param
+ *  frames - количество слов, декодированных getDecode (NULL - не требуется)
+ *  hits - количество слов, принятых без ошибок и декодированных обращением кода
+ *         (NULL - не требуется)
+ */
+void getDecodeFastStats(uint64_t *frames, uint64_t *hits);
+
+/**
+ * @brief функция декодирует слово по мягким решениям демодулятора
+ *        (см. getDecode). Метрика символа - max(0, -llr) для нуля и max(0, llr)
+ *        для единицы; символ с llr = 0 считается стертым
+ * @param
+ *  llr - логарифмические отношения правдоподобия кодовых символов
+ *        (llr > 0 - вероятнее 0, llr < 0 - вероятнее 1)
+ *  codeWordSize - количество кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти
+ */
+bool getDecodeSoft(const int8_t *llr, unsigned int codeWordSize,
+                   unsigned int *decodeWord, unsigned int decodeWordSize);
+
+/**
+ * @brief функция декодирует слово по квантованным символам демодулятора
+ *        (см. getDecode). Метрики ветвей берутся из таблицы по паре символов;
+ *        при bits = 1 декодирование совпадает с декодированием жестких решений
+ * @param
+ *  symbols - кодовые символы из bits младших разрядов: 0 - уверенный 0,
+ *            2^bits - 1 - уверенная 1
+ *  codeWordSize - количество кодовых символов
+ *  bits - разрядность символов, от 1 до SOFT_MAX_BITS
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return true, если разрядность допустима и памяти достаточно
+ */
+bool getDecodeQuantized(const uint8_t *symbols, unsigned int codeWordSize, unsigned int bits,
+                        unsigned int *decodeWord, unsigned int decodeWordSize);
+
+/**
+ * @brief размер рабочей области для getDecodeWorkspace
+ * @param
+ *  codeWordSize - количество кодовых символов
+ *  options - вид кодовых символов (DECODE_HARD, DECODE_LLR, DECODE_QUANTIZED(bits))
+ * @return размер в байтах или 0, если вид кодовых символов неизвестен
+ */
+size_t getDecodeWorkspaceSize(unsigned int codeWordSize, unsigned int options);
+
+/**
+ * @brief функция декодирует слово (см. getDecode, getDecodeSoft,
+ *        getDecodeQuantized) целиком в рабочей области вызывающей стороны.
+ *        Память не выделяется, размер стека не зависит от длины слова, поэтому
+ *        область можно выделить заранее (например, по потоку и в больших
+ *        страницах) и использовать повторно. Результат совпадает с
+ *        соответствующей функцией декодирования
+ * @param
+ *  codeWord - кодовые символы вида options
+ *  codeWordSize - количество кодовых символов
+ *  options - вид кодовых символов (DECODE_HARD, DECODE_LLR, DECODE_QUANTIZED(bits))
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ *  workspace - рабочая область, выровненная на DECODE_WORKSPACE_ALIGN
+ *  workspaceSize - размер рабочей области, не меньше getDecodeWorkspaceSize
+ * @return false, если вид символов неизвестен, а область не выровнена или мала
+ */
+bool getDecodeWorkspace(const void *codeWord, unsigned int codeWordSize, unsigned int options,
+                        unsigned int *decodeWord, unsigned int decodeWordSize,
+                        void *workspace, size_t workspaceSize);
+
+/**
+ * @brief функция декодирует упакованное кодовое слово (см. getCodeWordPackedOrder)
+ *        и упаковывает результат с тем же порядком битов. Символы выдаются в
+ *        порядке поступления в кодер: результат совпадает с исходным словом
+ *        getCodeWordPackedOrder. Символы по одному на unsigned int не создаются
+ * @param
+ *  codeWord - упакованное кодовое слово
+ *  codeBits - длина кодового слова в битах
+ *  decodeWord - упакованное декодированное слово, не менее (wordLen + 7)/8 байт
+ *  wordLen - длина декодированного слова в битах
+ *  order - порядок битов в байтах кодового и декодированного слов
+ * @return false при нехватке памяти (декодированное слово остается нулевым)
+ */
+bool getDecodePacked(const uint8_t *codeWord, unsigned int codeBits,
+                     uint8_t *decodeWord, unsigned int wordLen, eBitOrder order);
+
+/**
+ * @brief функция декодирует длинное слово на нескольких потоках (см. getDecode).
+ *        Шаги решетки разбиваются на участки по segmentSize шагов; каждый участок
+ *        декодируется независимо в окне, расширенном на overlap шагов с обеих
+ *        сторон, перекрытия отбрасываются. При перекрытии от DECODER_DEPTH шагов
+ *        доля ошибок совпадает с getDecode
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ *  threads - количество потоков (большее MAX_THREADS уменьшается до MAX_THREADS)
+ *  segmentSize - количество шагов в участке (0 - поровну между потоками)
+ *  overlap - количество шагов перекрытия
+ * @return false при нехватке памяти
+ */
+bool getDecodeParallel(unsigned int *codeWord, unsigned int codeWordSize,
+                       unsigned int *decodeWord, unsigned int decodeWordSize,
+                       unsigned int threads, unsigned int segmentSize, unsigned int overlap);
+
+/**
+ * @brief функция декодирует count кадров одинаковой длины (см. getDecode).
+ *        Кадры обрабатываются группами по ACS_LANES (см. acs.h), все кадры
+ *        группы одновременно проходят метрики ветвей, шаги ACS и обратный
+ *        проход. Неполная последняя группа менее 3/4 ACS_LANES кадров (и весь
+ *        пакет такого размера) декодируется по одному кадру без выделения
+ *        памяти под группу. Результат для каждого кадра совпадает с getDecode
+ * @param
+ *  codeWords - кодовые слова кадров
+ *  count - количество кадров
+ *  codeWordSize - размер кодового слова кадра
+ *  decodeWords - декодированные слова кадров
+ *  decodeWordSize - размер декодированного слова кадра
+ * @return false при нехватке памяти
+ */
+bool getDecodeBatch(unsigned int *const codeWords[], unsigned int count, unsigned int codeWordSize,
+                    unsigned int *const decodeWords[], unsigned int decodeWordSize);
+
+/**
+ * @brief функция декодирует слово, выполняя шаги ACS только вокруг ошибок
+ *        (см. getDecode). На участках, где принятые символы совпадают с
+ *        повторно закодированным путем (синдром равен нулю), символы выдаются
+ *        обращением кода, а метрики путей известны без вычислений (см.
+ *        distanceTable). Результат совпадает с getDecode; время декодирования
+ *        растет с количеством ошибок, а не с длиной слова
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти
+ */
+bool getDecodeSyndrome(unsigned int *codeWord, unsigned int codeWordSize,
+                       unsigned int *decodeWord, unsigned int decodeWordSize);
+
+/**
+ * @brief инициализация контекста потокового декодера (нулевое начальное состояние)
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  depth - глубина обратного прохода, от SIZE+1 до DECODER_MAX_DEPTH
+ *          (0 - DECODER_DEPTH)
+ * @return true, если глубина допустима
+ */
+bool decoderInit(sDecoder *decoder, unsigned int depth);
+
+/**
+ * @brief включение режима ранних решений: обратный проход множества всех
+ *        состояний ищет шаг, на котором сошлись все выжившие пути, и символы до
+ *        этого шага выдаются сразу - они совпадают с символами полного обратного
+ *        прохода. Следующий поиск выполняется через столько шагов, на сколько
+ *        точка схождения отставала при предыдущем, поэтому поиск стоит в
+ *        среднем около шага на шаг декодирования. Глубина depth остается
+ *        верхней границей задержки. Каждая выдача передается также в callback
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  callback - функция получения выданных символов (NULL - только буфер output)
+ *  context - указатель, передаваемый в callback
+ */
+void decoderSetEarly(sDecoder *decoder, tDecoderOutput callback, void *context);
+
+/**
+ * @brief декодирование очередной части потока (см. coderPush). Часть может
+ *        иметь любую длину, в том числе не кратную N. Символы выдаются в порядке
+ *        следования в потоке с задержкой от depth до 2*depth шагов (в режиме
+ *        ранних решений - как только сошлись выжившие пути)
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  codeWord - кодовые символы части потока (0, 1 или ERASURE)
+ *  len - количество кодовых символов
+ *  output - буфер декодированных символов, не менее (len + N - 1)/N + 2*depth
+ *           элементов (NULL - символы передаются только в callback)
+ * @return количество выданных символов
+ */
+unsigned int decoderPush(sDecoder *decoder, const unsigned int *codeWord, unsigned int len,
+                         unsigned int *output);
+
+/**
+ * @brief завершение потока, закодированного с хвостом из SIZE-1 нулей
+ *        (см. coderFlush): выдача оставшихся символов без хвоста и возврат
+ *        декодера в нулевое начальное состояние
+ * @param
+ *  decoder - указатель на контекст декодера
+ *  output - буфер декодированных символов, не менее 2*depth элементов
+ *           (NULL - символы передаются только в callback)
+ * @return количество выданных символов
+ */
+unsigned int decoderFlush(sDecoder *decoder, unsigned int *output);
+
+/**
+ * @brief инициализация контекста декодера поиском по дереву
+ * @param
+ *  decoder - указатель на контекст
+ */
+void treeDecoderInit(sTreeDecoder *decoder);
+
+/**
+ * @brief освобождение памяти контекста декодера поиском по дереву
+ * @param
+ *  decoder - указатель на контекст
+ */
+void treeDecoderFree(sTreeDecoder *decoder);
+
+/**
+ * @brief функция запускает декодирование слова поиском по дереву вероятных
+ *        путей с глубиной DEPTH (исходный декодер, см. viterby) в контексте
+ *        decoder. Кодовое слово не должно превышать S последовательностей из
+ *        N символов
+ * @param
+ *  decoder - указатель на контекст декодера (пул узлов сохраняется между вызовами)
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер мдекодированный массив
+ *  decodeWordSize - размер выходного декодированного массива
+ *  decodeWord - декодированное слово
+ */
+void getDecodeTreeWith(sTreeDecoder *decoder, unsigned int *codeWord, unsigned int codeWordSize,
+                       unsigned int *decodeWord, unsigned int decodeWordSize);
+
+/**
+ * @brief функция запускает декодирование слова поиском по дереву вероятных
+ *        путей (см. getDecodeTreeWith) во временном контексте
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер мдекодированный массив
+ *  decodeWordSize - размер выходного декодированного массива
+ *  decodeWord - декодированное слово
+ */
+void getDecodeTree(unsigned int *codeWord, unsigned int codeWordSize,
+                   unsigned int *decodeWord, unsigned int decodeWordSize);
+
+/**
+ * @brief функция декодирует слово, закодированное с циклическим завершением
+ *        (см. getCodeWordTailBiting). Слово циклически продолжается на TB_WRAP
+ *        шагов перед началом (метрики сходятся к метрикам конца слова) и после
+ *        конца (обратный проход начинается с лучшего состояния в конце
+ *        продолжения, поэтому решения последних шагов слова учитывают начало
+ *        слова). Результат практически совпадает с декодированием по максимуму
+ *        правдоподобия среди слов с циклическим завершением; слово короче
+ *        TB_WRAP шагов декодируется по максимуму правдоподобия перебором
+ *        начального состояния
+ * @param
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов (N символов на входной символ)
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти (слово не декодируется)
+ */
+bool getDecodeTailBiting(unsigned int *codeWord, unsigned int codeWordSize,
+                         unsigned int *decodeWord, unsigned int decodeWordSize);
+
+/**
+ * @brief функция декодирует слово, закодированное произвольным сверточным кодом
+ *        (см. trellisEncode), по алгоритму Витерби на решетке кода. Начальное
+ *        состояние нулевое; если слово содержит полный хвост из K-2 нулей,
+ *        обратный проход начинается с лучшего из состояний, допустимых после хвоста
+ * @param
+ *  trellis - решетка кода (см. buildTrellis)
+ *  codeWord - массив кодовых символов
+ *  codeWordSize - размер массива кодовых символов
+ *  decodeWord - декодированное слово
+ *  decodeWordSize - размер выходного декодированного массива
+ * @return false при нехватке памяти (слово не декодируется)
+ */
+bool trellisDecode(const sTrellis *trellis, const unsigned int *codeWord, unsigned int codeWordSize,
+                   unsigned int *decodeWord, unsigned int decodeWordSize);
+
 /**
  * @brief фкнуция получения вероятных путей по алгоритму Витерби
  * @param
- *  tree - указатель на текущий узел дерева возможных путей
+ *  decoder - указатель на контекст декодера
+ *  tree - номер текущего узла дерева возможных путей
  *  NSInd - текущий индекс массива последовательносте из N-символов
  *  depth - глубина поиска
  */
 //void viterby(unsigned int *pathInd, unsigned int *NSInd);
-sTree *viterby(sTree *tree, unsigned int *NSInd, unsigned int *depth);
+uint32_t viterby(sTreeDecoder *decoder, uint32_t tree, unsigned int *NSInd, unsigned int *depth);
 
 /**
  * @brief функция добавляет в дерево вероятных путей новый узел
  * @param
+ *  pool - указатель на пул узлов дерева
  *  data - значение нового узла дерева
  *  codeIndex - индекс массива последовательностей, при котором произошло ветвление
- *  node - указатель на новый узел дерева
+ *  node - номер узла дерева (TREE_NONE - создать новый узел)
  *  left -  флаг, указывающий, в какое поддерево будет добавлен нвый узел.
  *          При left = true узел будет добавлен в левое поддерево, иначе - в правое.
  */
-sTree *addNode(unsigned int data, unsigned int codeIndex, sTree *node, bool left);
+uint32_t addNode(sTreePool *pool, unsigned int data, unsigned int codeIndex, uint32_t node, bool left);
 
 /**
  * @brief функция добавляет в поддерево вероятных путей новый узел
  * @param
+ *  pool - указатель на пул узлов дерева
  *  data - значение нового узла дерева
  *  codeIndex - индекс массива последовательностей, при котором произошло ветвление
- *  node - указатель на новый узел дерева
+ *  node - номер узла дерева (TREE_NONE - создать новый узел)
  *  left -  флаг, указывающий, в какое поддерево будет добавлен нвый узел.
- *  parent - указатель на родительский узел
+ *  parent - номер родительского узла
  */
-sTree *createBranch(unsigned int data, unsigned int codeIndex, sTree *node, sTree *parent, bool left);
+uint32_t createBranch(sTreePool *pool, unsigned int data, unsigned int codeIndex, uint32_t node, uint32_t parent, bool left);
 
 /**
  * @brief фкнуция, очищающая массив вероятных путей
@@ -137,7 +554,8 @@ void clearPath(sPath path[S], unsigned int pathSize);
 /**
  * @brief фкнуция подсчета метрики Хэмминга.
  *        Метрика Хэмминга рассчитывается как количество
- *        различающихся символов в двух массивах.
+ *        различающихся символов в двух массивах. Стертые символы
+ *        (ERASURE) первого массива не учитываются.
  * @param
  *  tree - указатель на текущий узел дерева путей
  *  array_1 - указатель на первый массив
@@ -158,11 +576,27 @@ void splitWord(unsigned int *word, unsigned int wordSize,
                unsigned int split[S][N], unsigned int *splitSize);
 
 /**
- * @brief Функция удаляет дерево
+ * @brief выделение узла дерева путей из пула
+ * @param
+ *  pool - указатель на пул
+ * @return номер узла или TREE_NONE, если память не выделена
+ */
+uint32_t treeAlloc(sTreePool *pool);
+
+/**
+ * @brief сброс пула: все выданные узлы освобождаются за O(1), память массива
+ *        сохраняется
+ * @param
+ *  pool - указатель на пул
+ */
+void treeReset(sTreePool *pool);
+
+/**
+ * @brief освобождение памяти пула
  * @param
- *  tree - указатель на дерево
+ *  pool - указатель на пул
  */
-void removeTree(sTree *tree);
+void treeFree(sTreePool *pool);
 
 /**
  * @brief Функция проверяет полученный массив путей и выбирает из него наиболее оптимальный.
@@ -180,13 +614,14 @@ int checkPath(unsigned int *checked, unsigned int checkedSize, unsigned int *chI
 /**
  * @brief Функция анализирует дерево путей и строит на его основе массив вероятных путей
  * @param
- *  tree - указатель на дерево возможных путей
+ *  pool - указатель на пул узлов дерева
+ *  tree - номер корня дерева возможных путей
  *  path - массив путей
  *  size - размер массива путей
  *  visit - флаг посещения узла
  *  isFirst - флаг первого посещения дерева
  */
-void getPaths(sTree* tree, sPath path[S], unsigned int *size,
+void getPaths(const sTreePool *pool, uint32_t tree, sPath path[S], unsigned int *size,
               bool *visit, bool *isFirst);
 
 /**
@@ -196,7 +631,7 @@ void getPaths(sTree* tree, sPath path[S], unsigned int *size,
  *  size - текущий размер массива путей
  *  value - указатель на соответствующий узер дерева путей
  */
-void appendValue(sPath path[S], unsigned int size, sTree *value);
+void appendValue(sPath path[S], unsigned int size, const sTree *value);
 
 /**
  * @brief Функция возвращает минимальный индекс массива вероятных путей